@@ -0,0 +1,125 @@
+#include "Assets.h"
+
+#include <filesystem>
+
+#ifdef HEXX_EMBED_ASSETS
+#include "FontMonogram.h"
+#include "SoundBoop.h"
+#include "MusicSans.h"
+#endif
+
+//Directory tried when an asset is not found relative to the working directory
+static std::string assetDirectory;
+
+/**
+ * @brief Sets the directory assets are looked for in when the working directory lacks them.
+ * @param directory Usually the directory of the executable.
+ */
+void setAssetDirectory(const std::string& directory) {
+    assetDirectory = directory;
+}
+
+/**
+ * @brief Finds the file of an asset.
+ * Paths use forward slashes, which every platform accepts.
+ *
+ * @param asset Asset to find.
+ * @return Path relative to the working directory if the file is there, otherwise in the asset directory.
+ */
+std::string assetPath(Asset asset) {
+    std::filesystem::path relative;
+    switch (asset) {
+        case Asset::Font:
+            relative = "Fonts/monogram.ttf";
+            break;
+        case Asset::Boop:
+            relative = "Music/realBoop.wav";
+            break;
+        case Asset::Music:
+            relative = "Music/sans.ogg";
+            break;
+    }
+    std::error_code error;
+    if (!std::filesystem::exists(relative, error) && !assetDirectory.empty() &&
+        std::filesystem::exists(std::filesystem::path(assetDirectory) / relative, error)) {
+        return (std::filesystem::path(assetDirectory) / relative).string();
+    }
+    return relative.string();
+}
+
+/**
+ * @brief Finds the bytes of an asset compiled into the binary.
+ *
+ * @param asset Asset to find.
+ * @param data Set to the bytes, which stay valid for the whole run.
+ * @param size Set to the number of bytes.
+ * @return False if the assets were not compiled in.
+ */
+static bool embeddedAsset([[maybe_unused]] Asset asset, [[maybe_unused]] const void*& data,
+                          [[maybe_unused]] std::size_t& size) {
+#ifdef HEXX_EMBED_ASSETS
+    switch (asset) {
+        case Asset::Font:
+            data = FONT_MONOGRAM;
+            size = FONT_MONOGRAM_SIZE;
+            return true;
+        case Asset::Boop:
+            data = SOUND_BOOP;
+            size = SOUND_BOOP_SIZE;
+            return true;
+        case Asset::Music:
+            data = MUSIC_SANS;
+            size = MUSIC_SANS_SIZE;
+            return true;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @brief Loads a font from the binary if it was compiled in, otherwise from its file.
+ *
+ * @param font Font to load.
+ * @param asset Asset holding the font.
+ * @return False if the font could not be loaded.
+ */
+bool loadFont(sf::Font& font, Asset asset) {
+    const void* data;
+    std::size_t size;
+    if (embeddedAsset(asset, data, size)) {
+        return font.loadFromMemory(data, size);
+    }
+    return font.loadFromFile(assetPath(asset));
+}
+
+/**
+ * @brief Decodes a sound from the binary if it was compiled in, otherwise from its file.
+ *
+ * @param buffer Buffer to decode into.
+ * @param asset Asset holding the sound.
+ * @return False if the sound could not be decoded.
+ */
+bool loadSoundBuffer(sf::SoundBuffer& buffer, Asset asset) {
+    const void* data;
+    std::size_t size;
+    if (embeddedAsset(asset, data, size)) {
+        return buffer.loadFromMemory(data, size);
+    }
+    return buffer.loadFromFile(assetPath(asset));
+}
+
+/**
+ * @brief Opens music for streaming from the binary if it was compiled in, otherwise from its file.
+ *
+ * @param music Music to open.
+ * @param asset Asset holding the music.
+ * @return False if the music could not be opened.
+ */
+bool openMusic(sf::Music& music, Asset asset) {
+    const void* data;
+    std::size_t size;
+    if (embeddedAsset(asset, data, size)) {
+        return music.openFromMemory(data, size);
+    }
+    return music.openFromFile(assetPath(asset));
+}
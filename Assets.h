@@ -0,0 +1,22 @@
+#include "SFML/Audio.hpp"
+#include "SFML/Graphics.hpp"
+
+#include <string>
+
+#ifndef HEXXAGON_ASSETS_H
+#define HEXXAGON_ASSETS_H
+
+enum class Asset {
+    Font,
+    Boop,
+    Music
+};
+
+void setAssetDirectory(const std::string& directory);
+std::string assetPath(Asset asset);
+bool loadFont(sf::Font& font, Asset asset);
+bool loadSoundBuffer(sf::SoundBuffer& buffer, Asset asset);
+bool openMusic(sf::Music& music, Asset asset);
+
+
+#endif //HEXXAGON_ASSETS_H
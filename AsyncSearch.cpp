@@ -0,0 +1,89 @@
+#include "AsyncSearch.h"
+
+/**
+ * @brief Constructs an AsyncSearch object.
+ * @param engine Engine that computes the moves.
+ */
+AsyncSearch::AsyncSearch(std::unique_ptr<Engine> engine) : engine(std::move(engine)) {
+}
+
+/**
+ * @brief Destroys the AsyncSearch object.
+ * Stops a running search and waits for the worker thread.
+ */
+AsyncSearch::~AsyncSearch() {
+    this->cancel();
+}
+
+/**
+ * @brief Replaces the engine. A search still running is cancelled first.
+ * @param engine Engine that computes the next moves.
+ */
+void AsyncSearch::setEngine(std::unique_ptr<Engine> engine) {
+    this->cancel();
+    this->engine = std::move(engine);
+}
+
+/**
+ * @brief Starts searching a position on the worker thread. A search still running is cancelled first.
+ *
+ * @param board Position to search. It is copied, so the caller may change its own board afterwards.
+ * @param limits Limits of the search. Its stop flag is replaced by the one cancel raises.
+ */
+void AsyncSearch::start(const Board& board, const SearchLimits& limits) {
+    this->cancel();
+    this->stopFlag.store(false);
+    this->finished.store(false);
+    this->running = true;
+
+    SearchLimits workerLimits = limits;
+    workerLimits.stop = &this->stopFlag;
+    this->worker = std::thread([this, board, workerLimits]() {
+        this->result = this->engine->run(board, workerLimits);
+        this->finished.store(true, std::memory_order_release);
+    });
+}
+
+/**
+ * @brief Checks whether the running search has finished. Never blocks.
+ *
+ * @param result Filled with the search result when it is ready.
+ * @return True exactly once per started search, when its result is handed over.
+ */
+bool AsyncSearch::poll(SearchResult& result) {
+    if (!this->running || !this->finished.load(std::memory_order_acquire)) {
+        return false;
+    }
+    this->worker.join();
+    this->running = false;
+    result = this->result;
+    return true;
+}
+
+/**
+ * @brief Tells whether a search was started and its result not collected yet.
+ * @return True while a search is in progress or waiting to be polled.
+ */
+bool AsyncSearch::thinking() const {
+    return this->running;
+}
+
+/**
+ * @brief Stops the running search, if any, and discards its result.
+ */
+void AsyncSearch::cancel() {
+    if (!this->running) {
+        return;
+    }
+    this->stopFlag.store(true);
+    this->worker.join();
+    this->running = false;
+}
+
+/**
+ * @brief Retrieves the number of search threads.
+ * @return Thread count of the engine.
+ */
+int AsyncSearch::threadCount() const {
+    return this->engine->threadCount();
+}
@@ -0,0 +1,36 @@
+#include "Engine.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#ifndef HEXXAGON_ASYNCSEARCH_H
+#define HEXXAGON_ASYNCSEARCH_H
+
+/**
+ * @brief Runs an Engine from a worker thread so the caller can keep its frame loop going.
+ * Start a search, then poll once per frame until the result arrives.
+ */
+class AsyncSearch {
+public:
+    explicit AsyncSearch(std::unique_ptr<Engine> engine);
+    virtual ~AsyncSearch();
+
+    void setEngine(std::unique_ptr<Engine> engine);
+    void start(const Board& board, const SearchLimits& limits);
+    bool poll(SearchResult& result);
+    bool thinking() const;
+    void cancel();
+    int threadCount() const;
+
+private:
+    std::unique_ptr<Engine> engine;
+    std::thread worker;
+    std::atomic<bool> stopFlag{false};
+    std::atomic<bool> finished{false};
+    bool running = false;
+    SearchResult result;
+};
+
+
+#endif //HEXXAGON_ASYNCSEARCH_H
@@ -0,0 +1,194 @@
+#include "BatchEvaluation.h"
+#include "CpuFeatures.h"
+#include "Hex.h"
+
+#include <algorithm>
+
+//Positions evaluated per pass of evaluateBatch, so the features fit on the stack
+constexpr size_t FEATURE_BLOCK = 64;
+
+/**
+ * @brief Reduces a board to the pawns of the side to move and of the other side.
+ * @param board Position to pack.
+ * @return The packed position.
+ */
+PackedPosition packPosition(const Board& board) {
+    Bitboard own = board.pieces(board.sideToMove);
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    return {own.lo, own.hi, enemy.lo, enemy.hi};
+}
+
+/**
+ * @brief Computes the evaluation terms one position at a time.
+ *
+ * @param positions Positions to evaluate.
+ * @param count Number of positions.
+ * @param features Filled with the terms of every position.
+ */
+static void evaluationFeaturesScalar(const PackedPosition* positions, size_t count, EvalFeatures* features) {
+    for (size_t i = 0; i < count; i++) {
+        const PackedPosition& p = positions[i];
+        features[i] = evaluationFeatures(Bitboard(p.ownLo, p.ownHi), Bitboard(p.enemyLo, p.enemyHi));
+    }
+}
+
+#ifdef HEXX_AVX2_KERNEL
+
+/**
+ * @brief The same cell set of four positions: the low words in one register, the high words in the other.
+ */
+struct Lanes {
+    __m256i lo;
+    __m256i hi;
+};
+
+HEXX_AVX2_TARGET static inline Lanes broadcast(Bitboard mask) {
+    return {_mm256_set1_epi64x(static_cast<long long>(mask.lo)), _mm256_set1_epi64x(static_cast<long long>(mask.hi))};
+}
+
+HEXX_AVX2_TARGET static inline Lanes operator&(Lanes a, Lanes b) {
+    return {_mm256_and_si256(a.lo, b.lo), _mm256_and_si256(a.hi, b.hi)};
+}
+
+HEXX_AVX2_TARGET static inline Lanes operator|(Lanes a, Lanes b) {
+    return {_mm256_or_si256(a.lo, b.lo), _mm256_or_si256(a.hi, b.hi)};
+}
+
+//Cells of b that are not in a
+HEXX_AVX2_TARGET static inline Lanes andNot(Lanes a, Lanes b) {
+    return {_mm256_andnot_si256(a.lo, b.lo), _mm256_andnot_si256(a.hi, b.hi)};
+}
+
+//Moves cell i to i + N, like Bitboard::operator<<
+template <int N>
+HEXX_AVX2_TARGET static inline Lanes shiftUp(Lanes a) {
+    return {_mm256_slli_epi64(a.lo, N), _mm256_or_si256(_mm256_slli_epi64(a.hi, N), _mm256_srli_epi64(a.lo, 64 - N))};
+}
+
+//Moves cell i to i - N, like Bitboard::operator>>
+template <int N>
+HEXX_AVX2_TARGET static inline Lanes shiftDown(Lanes a) {
+    return {_mm256_or_si256(_mm256_srli_epi64(a.lo, N), _mm256_slli_epi64(a.hi, 64 - N)), _mm256_srli_epi64(a.hi, N)};
+}
+
+/**
+ * @brief adjacentCells of Hex.h for four positions at once.
+ */
+HEXX_AVX2_TARGET static inline Lanes adjacentLanes(Lanes cells) {
+    const Lanes grid = broadcast(GRID);
+    const Lanes topRow = broadcast(TOP_ROW);
+    const Lanes bottomRow = broadcast(BOTTOM_ROW);
+    const Lanes evenColumns = broadcast(EVEN_COLUMNS);
+
+    Lanes notTop = andNot(topRow, cells);
+    Lanes notBottom = andNot(bottomRow, cells);
+    Lanes up = notTop & evenColumns;
+    Lanes down = andNot(evenColumns, notBottom);
+    Lanes result = shiftDown<1>(notTop) | shiftUp<1>(notBottom) | shiftUp<BOARD_SIZE>(cells) |
+                   shiftDown<BOARD_SIZE>(cells) | shiftUp<BOARD_SIZE - 1>(up) | shiftDown<BOARD_SIZE + 1>(up) |
+                   shiftUp<BOARD_SIZE + 1>(down) | shiftDown<BOARD_SIZE - 1>(down);
+    return result & grid;
+}
+
+/**
+ * @brief Counts the set bits of each 64-bit word: a nibble lookup per byte, then the bytes summed per word.
+ * AVX2 has no popcount instruction of its own.
+ */
+HEXX_AVX2_TARGET static inline __m256i popcountWords(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i low = _mm256_and_si256(v, nibble);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+HEXX_AVX2_TARGET static inline __m256i countLanes(Lanes a) {
+    return _mm256_add_epi64(popcountWords(a.lo), popcountWords(a.hi));
+}
+
+/**
+ * @brief Computes the evaluation terms four positions at a time, the rest one at a time.
+ * The four packed positions are transposed so each register holds the same word of all four.
+ *
+ * @param positions Positions to evaluate.
+ * @param count Number of positions.
+ * @param features Filled with the terms of every position.
+ */
+HEXX_AVX2_TARGET static void evaluationFeaturesAvx2(const PackedPosition* positions, size_t count,
+                                                    EvalFeatures* features) {
+    const Lanes playable = broadcast(PLAYABLE);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(positions + i));
+        __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(positions + i + 1));
+        __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(positions + i + 2));
+        __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(positions + i + 3));
+        __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+        Lanes own = {_mm256_permute2x128_si256(t0, t2, 0x20), _mm256_permute2x128_si256(t1, t3, 0x20)};
+        Lanes enemy = {_mm256_permute2x128_si256(t0, t2, 0x31), _mm256_permute2x128_si256(t1, t3, 0x31)};
+
+        Lanes empty = andNot(own | enemy, playable);
+        Lanes ownReach = adjacentLanes(adjacentLanes(own)) & empty;
+        Lanes enemyReach = adjacentLanes(adjacentLanes(enemy)) & empty;
+
+        alignas(32) int64_t material[4];
+        alignas(32) int64_t mobility[4];
+        alignas(32) int64_t safety[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(material), _mm256_sub_epi64(countLanes(own), countLanes(enemy)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(mobility),
+                           _mm256_sub_epi64(countLanes(ownReach), countLanes(enemyReach)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(safety),
+                           _mm256_sub_epi64(countLanes(enemy & adjacentLanes(ownReach)),
+                                            countLanes(own & adjacentLanes(enemyReach))));
+        for (int lane = 0; lane < 4; lane++) {
+            features[i + lane] = {static_cast<int>(material[lane]), static_cast<int>(mobility[lane]),
+                                  static_cast<int>(safety[lane])};
+        }
+    }
+    evaluationFeaturesScalar(positions + i, count - i, features + i);
+}
+
+#endif
+
+/**
+ * @brief Computes the evaluation terms of many positions, with the fastest kernel the CPU supports.
+ * Gives the same terms as evaluationFeatures for every position.
+ *
+ * @param positions Positions to evaluate.
+ * @param count Number of positions.
+ * @param features Filled with the terms of every position.
+ */
+void evaluationFeaturesBatch(const PackedPosition* positions, size_t count, EvalFeatures* features) {
+#ifdef HEXX_AVX2_KERNEL
+    if (useAvx2()) {
+        evaluationFeaturesAvx2(positions, count, features);
+        return;
+    }
+#endif
+    evaluationFeaturesScalar(positions, count, features);
+}
+
+/**
+ * @brief Scores many positions, each from the point of view of its side to move.
+ * Gives the same scores as evaluate for every position.
+ *
+ * @param positions Positions to score.
+ * @param count Number of positions.
+ * @param weights Weights of the terms.
+ * @param scores Filled with the score of every position, in hundredths of a pawn.
+ */
+void evaluateBatch(const PackedPosition* positions, size_t count, const EvalWeights& weights, int* scores) {
+    EvalFeatures features[FEATURE_BLOCK];
+    for (size_t start = 0; start < count; start += FEATURE_BLOCK) {
+        size_t block = std::min(FEATURE_BLOCK, count - start);
+        evaluationFeaturesBatch(positions + start, block, features);
+        for (size_t i = 0; i < block; i++) {
+            scores[start + i] = weighFeatures(features[i], weights);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#include "Board.h"
+#include "Evaluation.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef HEXXAGON_BATCHEVALUATION_H
+#define HEXXAGON_BATCHEVALUATION_H
+
+/**
+ * @brief Position reduced to what the evaluation reads: the pawns of the side to move and of the other side,
+ * low word first. Four of them fill two cache lines.
+ */
+struct PackedPosition {
+    uint64_t ownLo = 0;
+    uint64_t ownHi = 0;
+    uint64_t enemyLo = 0;
+    uint64_t enemyHi = 0;
+};
+
+PackedPosition packPosition(const Board& board);
+void evaluationFeaturesBatch(const PackedPosition* positions, size_t count, EvalFeatures* features);
+void evaluateBatch(const PackedPosition* positions, size_t count, const EvalWeights& weights, int* scores);
+
+
+#endif //HEXXAGON_BATCHEVALUATION_H
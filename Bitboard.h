@@ -0,0 +1,84 @@
+#include <bit>
+#include <cstdint>
+
+#ifndef HEXXAGON_BITBOARD_H
+#define HEXXAGON_BITBOARD_H
+
+/**
+ * @brief Set of board cells stored as two 64-bit words.
+ * Bit i stands for the cell with index i (column * 9 + row), so the 81 cells of the board fit in one value.
+ */
+struct Bitboard {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    constexpr Bitboard() = default;
+    constexpr Bitboard(uint64_t low, uint64_t high) : lo(low), hi(high) {}
+
+    /**
+     * @brief Creates a set holding a single cell.
+     * @param i Index of the cell.
+     */
+    static constexpr Bitboard cell(int i) {
+        return i < 64 ? Bitboard(1ull << i, 0) : Bitboard(0, 1ull << (i - 64));
+    }
+
+    constexpr bool test(int i) const {
+        return i < 64 ? (lo >> i) & 1 : (hi >> (i - 64)) & 1;
+    }
+
+    constexpr void set(int i) {
+        *this |= cell(i);
+    }
+
+    constexpr void reset(int i) {
+        *this &= ~cell(i);
+    }
+
+    constexpr int count() const {
+        return std::popcount(lo) + std::popcount(hi);
+    }
+
+    constexpr bool any() const {
+        return (lo | hi) != 0;
+    }
+
+    constexpr bool none() const {
+        return (lo | hi) == 0;
+    }
+
+    /**
+     * @brief Index of the lowest set cell. The set must not be empty.
+     */
+    constexpr int lsb() const {
+        return lo ? std::countr_zero(lo) : 64 + std::countr_zero(hi);
+    }
+
+    /**
+     * @brief Removes the lowest set cell and returns its index. The set must not be empty.
+     */
+    constexpr int popLsb() {
+        int i = this->lsb();
+        if (lo) {
+            lo &= lo - 1;
+        } else {
+            hi &= hi - 1;
+        }
+        return i;
+    }
+
+    constexpr Bitboard operator&(const Bitboard& o) const { return {lo & o.lo, hi & o.hi}; }
+    constexpr Bitboard operator|(const Bitboard& o) const { return {lo | o.lo, hi | o.hi}; }
+    constexpr Bitboard operator^(const Bitboard& o) const { return {lo ^ o.lo, hi ^ o.hi}; }
+    constexpr Bitboard operator~() const { return {~lo, ~hi}; }
+    //Shifts move cell i to i + n or i - n, for 0 < n < 64
+    constexpr Bitboard operator<<(int n) const { return {lo << n, (hi << n) | (lo >> (64 - n))}; }
+    constexpr Bitboard operator>>(int n) const { return {(lo >> n) | (hi << (64 - n)), hi >> n}; }
+    constexpr Bitboard& operator&=(const Bitboard& o) { lo &= o.lo; hi &= o.hi; return *this; }
+    constexpr Bitboard& operator|=(const Bitboard& o) { lo |= o.lo; hi |= o.hi; return *this; }
+    constexpr Bitboard& operator^=(const Bitboard& o) { lo ^= o.lo; hi ^= o.hi; return *this; }
+    constexpr bool operator==(const Bitboard& o) const = default;
+};
+
+
+#endif //HEXXAGON_BITBOARD_H
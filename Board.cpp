@@ -0,0 +1,289 @@
+#include "Board.h"
+#include "Hex.h"
+#include "Zobrist.h"
+
+/**
+ * @brief Builds the standard starting position with three pawns per side, white to move.
+ * @return The starting board.
+ */
+Board Board::startingPosition() {
+    Board board;
+    board.place(44, Side::White);
+    board.place(74, Side::White);
+    board.place(2, Side::White);
+    board.place(6, Side::Black);
+    board.place(36, Side::Black);
+    board.place(78, Side::Black);
+    board.setSideToMove(Side::White);
+    return board;
+}
+
+/**
+ * @brief Reads a position written by toString.
+ *
+ * @param text Nine columns of nine cells separated by '/', a space and the side to move ('w' or 'b').
+ *             Cells are 'w', 'b', '.' for empty and '-' for a hole.
+ * @param board Set to the position if the text is valid.
+ * @return True if the text was valid.
+ */
+bool Board::fromString(const std::string& text, Board& board) {
+    if (text.size() != CELL_COUNT + (BOARD_SIZE - 1) + 2) {
+        return false;
+    }
+    Board parsed;
+    size_t pos = 0;
+    for (int column = 0; column < BOARD_SIZE; column++) {
+        if (column > 0 && text[pos++] != '/') {
+            return false;
+        }
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            int cell = column * BOARD_SIZE + row;
+            char c = text[pos++];
+            if ((c == '-') != !isPlayable(cell)) {
+                return false;
+            }
+            if (c == 'w') {
+                parsed.place(cell, Side::White);
+            } else if (c == 'b') {
+                parsed.place(cell, Side::Black);
+            } else if (c != '.' && c != '-') {
+                return false;
+            }
+        }
+    }
+    if (text[pos++] != ' ' || (text[pos] != 'w' && text[pos] != 'b')) {
+        return false;
+    }
+    parsed.setSideToMove(text[pos] == 'w' ? Side::White : Side::Black);
+    board = parsed;
+    return true;
+}
+
+/**
+ * @brief Retrieves the pawns of one side.
+ * @param side Side whose pawns are requested.
+ * @return Mask of the cells occupied by that side.
+ */
+Bitboard Board::pieces(Side side) const {
+    return side == Side::White ? this->white : this->black;
+}
+
+/**
+ * @brief Retrieves all occupied cells.
+ * @return Mask of the cells occupied by either side.
+ */
+Bitboard Board::occupied() const {
+    return this->white | this->black;
+}
+
+/**
+ * @brief Retrieves the playable cells nobody occupies.
+ * @return Mask of the empty cells.
+ */
+Bitboard Board::empty() const {
+    return PLAYABLE & ~this->occupied();
+}
+
+/**
+ * @brief Counts the pawns of one side.
+ * @param side Side whose pawns are counted.
+ * @return Number of pawns.
+ */
+int Board::count(Side side) const {
+    return this->pieces(side).count();
+}
+
+/**
+ * @brief Checks whether the game has ended, which happens when the side to move has no move.
+ * A full board and a side without pawns are both covered. The check is a few shifts, so it can run after every move.
+ *
+ * @return True if no pawn of the side to move reaches an empty cell.
+ */
+bool Board::isGameOver() const {
+    return (cellsWithinTwo(this->pieces(this->sideToMove)) & this->empty()).none();
+}
+
+/**
+ * @brief Counts the points of one side.
+ * When the game is over the side that could still move claims every empty cell.
+ *
+ * @param side Side whose points are counted.
+ * @return Number of pawns, plus the empty cells if the opponent is the one left without a move.
+ */
+int Board::finalCount(Side side) const {
+    int points = this->count(side);
+    if (side != this->sideToMove && this->isGameOver()) {
+        points += this->empty().count();
+    }
+    return points;
+}
+
+/**
+ * @brief Retrieves the content of a cell.
+ * @param cell Index of the cell.
+ * @return What the cell holds.
+ */
+Piece Board::at(int cell) const {
+    if (!isPlayable(cell)) {
+        return Piece::Hole;
+    }
+    if (this->white.test(cell)) {
+        return Piece::White;
+    }
+    if (this->black.test(cell)) {
+        return Piece::Black;
+    }
+    return Piece::Empty;
+}
+
+/**
+ * @brief Puts a pawn of the given side on a cell, replacing whatever was there.
+ * @param cell Index of the cell.
+ * @param side Owner of the pawn.
+ */
+void Board::place(int cell, Side side) {
+    this->clear(cell);
+    if (side == Side::White) {
+        this->white.set(cell);
+    } else {
+        this->black.set(cell);
+    }
+    this->hash ^= zobristKey(side, cell);
+}
+
+/**
+ * @brief Removes the pawn from a cell.
+ * @param cell Index of the cell.
+ */
+void Board::clear(int cell) {
+    if (this->white.test(cell)) {
+        this->white.reset(cell);
+        this->hash ^= ZOBRIST.white[cell];
+    } else if (this->black.test(cell)) {
+        this->black.reset(cell);
+        this->hash ^= ZOBRIST.black[cell];
+    }
+}
+
+/**
+ * @brief Sets whose turn it is.
+ * @param side Side to move.
+ */
+void Board::setSideToMove(Side side) {
+    if (side != this->sideToMove) {
+        this->hash ^= ZOBRIST.blackToMove;
+        this->sideToMove = side;
+    }
+}
+
+/**
+ * @brief Computes the Zobrist hash from scratch.
+ * @return Hash of the pawns and the side to move, equal to the incrementally kept hash.
+ */
+uint64_t Board::computeHash() const {
+    uint64_t key = this->sideToMove == Side::Black ? ZOBRIST.blackToMove : 0;
+    for (Bitboard pawns = this->white; pawns.any();) {
+        key ^= ZOBRIST.white[pawns.popLsb()];
+    }
+    for (Bitboard pawns = this->black; pawns.any();) {
+        key ^= ZOBRIST.black[pawns.popLsb()];
+    }
+    return key;
+}
+
+/**
+ * @brief Writes the position as text, column by column.
+ * @return Text that fromString reads back, e.g. the start position begins "--w...b--/".
+ */
+std::string Board::toString() const {
+    static const char symbols[] = {'.', 'w', 'b', '-'};
+    std::string text;
+    for (int column = 0; column < BOARD_SIZE; column++) {
+        if (column > 0) {
+            text += '/';
+        }
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            text += symbols[static_cast<int>(this->at(column * BOARD_SIZE + row))];
+        }
+    }
+    text += this->sideToMove == Side::White ? " w" : " b";
+    return text;
+}
+
+/**
+ * @brief Hash difference a move makes, the same for playing and taking it back.
+ *
+ * @param side Side that plays the move.
+ * @param move The move.
+ * @param flipped Pawns the move flips.
+ * @return Keys to XOR into the hash.
+ */
+static uint64_t moveHashDelta(Side side, const Move& move, Bitboard flipped) {
+    uint64_t delta = ZOBRIST.blackToMove ^ zobristKey(side, move.to);
+    if (move.type == MoveType::Jump) {
+        delta ^= zobristKey(side, move.from);
+    }
+    while (flipped.any()) {
+        int cell = flipped.popLsb();
+        delta ^= ZOBRIST.white[cell] ^ ZOBRIST.black[cell];
+    }
+    return delta;
+}
+
+/**
+ * @brief Plays a move for the side to move and passes the turn.
+ * The move must be legal.
+ *
+ * @param move Move to play.
+ * @param record Filled with what unmakeMove needs to take the move back.
+ * @return Number of enemy pawns flipped.
+ */
+int Board::makeMove(const Move& move, MoveRecord& record) {
+    Side side = this->sideToMove;
+    Bitboard flipped = ADJACENT_CELLS[move.to] & this->pieces(opponent(side));
+    Bitboard changed = flipped | Bitboard::cell(move.to);
+
+    if (side == Side::White) {
+        this->white |= changed;
+        this->black ^= flipped;
+    } else {
+        this->black |= changed;
+        this->white ^= flipped;
+    }
+    if (move.type == MoveType::Jump) {
+        this->white.reset(move.from);
+        this->black.reset(move.from);
+    }
+
+    this->hash ^= moveHashDelta(side, move, flipped);
+    this->sideToMove = opponent(side);
+    record.move = move;
+    record.flipped = flipped;
+    return flipped.count();
+}
+
+/**
+ * @brief Takes back the last move played with makeMove.
+ *
+ * @param record Record filled by makeMove.
+ */
+void Board::unmakeMove(const MoveRecord& record) {
+    Side side = opponent(this->sideToMove);
+    const Move& move = record.move;
+
+    if (side == Side::White) {
+        this->white ^= record.flipped | Bitboard::cell(move.to);
+        this->black |= record.flipped;
+        if (move.type == MoveType::Jump) {
+            this->white.set(move.from);
+        }
+    } else {
+        this->black ^= record.flipped | Bitboard::cell(move.to);
+        this->white |= record.flipped;
+        if (move.type == MoveType::Jump) {
+            this->black.set(move.from);
+        }
+    }
+    this->hash ^= moveHashDelta(side, move, record.flipped);
+    this->sideToMove = side;
+}
@@ -0,0 +1,99 @@
+#include "Bitboard.h"
+#include "Move.h"
+
+#include <cstdint>
+#include <string>
+
+#ifndef HEXXAGON_BOARD_H
+#define HEXXAGON_BOARD_H
+
+enum class Side : uint8_t {
+    White,
+    Black
+};
+
+enum class Piece : uint8_t {
+    Empty,
+    White,
+    Black,
+    Hole
+};
+
+constexpr Side opponent(Side side) {
+    return side == Side::White ? Side::Black : Side::White;
+}
+
+constexpr int BOARD_SIZE = 9;
+constexpr int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+
+/**
+ * @brief Tells whether a cell is one of the holes carved out of the 9x9 layout.
+ * @param column Column of the cell.
+ * @param row Row of the cell.
+ */
+constexpr bool isHole(int column, int row) {
+    return (column == 0 && (row == 0 || row == 1 || row == 7 || row == 8)) ||
+           (column == 1 && (row == 0 || row == 7 || row == 8)) ||
+           (column == 2 && (row == 0 || row == 8)) ||
+           (column == 3 && (row == 8 || row == 4)) ||
+           (column == 4 && row == 3) ||
+           (column == 5 && (row == 8 || row == 4)) ||
+           (column == 6 && (row == 0 || row == 8)) ||
+           (column == 7 && (row == 0 || row == 7 || row == 8)) ||
+           (column == 8 && (row == 0 || row == 1 || row == 7 || row == 8));
+}
+
+/**
+ * @brief Builds the mask of the cells a pawn may stand on.
+ */
+constexpr Bitboard playableMask() {
+    Bitboard mask;
+    for (int column = 0; column < BOARD_SIZE; column++) {
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            if (!isHole(column, row)) {
+                mask.set(column * BOARD_SIZE + row);
+            }
+        }
+    }
+    return mask;
+}
+
+constexpr Bitboard PLAYABLE = playableMask();
+
+/**
+ * @brief Compact game state: one occupancy mask per side and the side to move.
+ * Cells are indexed column * 9 + row, the same order the fields and pawns are created in.
+ * The Zobrist hash is kept up to date by every mutator, so change the masks and the side through them.
+ */
+class Board {
+public:
+    Bitboard white;
+    Bitboard black;
+    Side sideToMove = Side::White;
+    uint64_t hash = 0;
+
+    static constexpr bool isPlayable(int cell) {
+        return PLAYABLE.test(cell);
+    }
+
+    static Board startingPosition();
+    static bool fromString(const std::string& text, Board& board);
+
+    Bitboard pieces(Side side) const;
+    Bitboard occupied() const;
+    Bitboard empty() const;
+    int count(Side side) const;
+    bool isGameOver() const;
+    int finalCount(Side side) const;
+    Piece at(int cell) const;
+    void place(int cell, Side side);
+    void clear(int cell);
+    void setSideToMove(Side side);
+    uint64_t computeHash() const;
+    std::string toString() const;
+    int makeMove(const Move& move, MoveRecord& record);
+    void unmakeMove(const MoveRecord& record);
+};
+
+
+#endif //HEXXAGON_BOARD_H
@@ -0,0 +1,39 @@
+#include "CpuFeatures.h"
+
+#include <cstdlib>
+
+#if defined(HEXX_AVX2_KERNEL) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Asks the CPU whether it runs AVX2, including whether the OS saves the wide registers.
+ */
+static bool cpuHasAvx2() {
+#ifndef HEXX_AVX2_KERNEL
+    return false;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/**
+ * @brief Tells whether the AVX2 kernels are used, decided once from the CPU.
+ * Setting the environment variable HEXX_DISABLE_AVX2 forces the scalar kernels, to compare the two.
+ * @return True if the AVX2 kernels are used.
+ */
+bool useAvx2() {
+    static const bool avx2 = std::getenv("HEXX_DISABLE_AVX2") == nullptr && cpuHasAvx2();
+    return avx2;
+}
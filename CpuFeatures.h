@@ -0,0 +1,19 @@
+#ifndef HEXXAGON_CPUFEATURES_H
+#define HEXXAGON_CPUFEATURES_H
+
+//x86-64 builds carry AVX2 kernels next to the scalar code and pick one at runtime
+#if defined(__x86_64__) || defined(_M_X64)
+#define HEXX_AVX2_KERNEL
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define HEXX_AVX2_TARGET
+#else
+//Compiles one function for AVX2 without raising the instruction set of the whole build
+#define HEXX_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+bool useAvx2();
+
+
+#endif //HEXXAGON_CPUFEATURES_H
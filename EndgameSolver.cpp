@@ -0,0 +1,255 @@
+#include "EndgameSolver.h"
+#include "Hex.h"
+#include "Zobrist.h"
+
+#include <algorithm>
+#include <utility>
+
+//Score of a line cut off at the horizon, beyond any final margin
+constexpr int UNFINISHED = 100;
+//Keeps the cache entries of the two provers apart
+constexpr uint64_t BLACK_PROVER_KEY = [] {
+    uint64_t state = 0x454E4447414D45ull;
+    return splitMix64(state);
+}();
+
+/**
+ * @brief Collects the empty cells that lie in connected groups of odd size.
+ * Whoever fills the last cell of such a group also moves last there, so moves into them come first.
+ *
+ * @param empty Empty cells.
+ * @return Union of the odd-sized groups.
+ */
+Bitboard oddRegions(Bitboard empty) {
+    Bitboard odd;
+    while (empty.any()) {
+        Bitboard region = Bitboard::cell(empty.lsb());
+        for (Bitboard grown = region; ; region = grown) {
+            grown = region | (adjacentCells(region) & empty);
+            if (grown == region) {
+                break;
+            }
+        }
+        if (region.count() % 2 == 1) {
+            odd |= region;
+        }
+        empty &= ~region;
+    }
+    return odd;
+}
+
+/**
+ * @brief Constructs an EndgameSolver object.
+ * @param cacheEntries Number of entries of the solved-position cache.
+ */
+EndgameSolver::EndgameSolver(size_t cacheEntries) : cache(cacheEntries) {
+}
+
+/**
+ * @brief Forgets every cached position.
+ */
+void EndgameSolver::clear() {
+    std::fill(this->cache.begin(), this->cache.end(), CacheEntry());
+}
+
+/**
+ * @brief Looks for a forced win within the limits, deepening the horizon one ply at a time.
+ * Each horizon is a null-window search around a margin of zero, so it only has to prove the win, not its size.
+ *
+ * @param board Position to solve.
+ * @param limits Node and time budget and stop flag. The depth limit is ignored.
+ * @return The result. If solved is false no win was proven before the budget ran out, and only the node count
+ *         is set.
+ */
+SolverResult EndgameSolver::solve(const Board& board, const SearchLimits& limits) {
+    this->limits = limits;
+    this->startTime = std::chrono::steady_clock::now();
+    this->nodes = 0;
+    this->aborted = false;
+
+    SolverResult result;
+    Board root = board;
+    if (!root.isGameOver()) {
+        for (int horizon = 1; horizon < MAX_PLY; horizon++) {
+            Move winningMove;
+            int margin = this->search(root, horizon, 0, 1, root.sideToMove, &winningMove);
+            if (this->aborted) {
+                break;
+            }
+            if (margin > 0) {
+                result.solved = true;
+                result.bestMove = winningMove;
+                result.margin = margin;
+                result.plies = horizon;
+                break;
+            }
+        }
+    }
+    result.nodes = this->nodes;
+    return result;
+}
+
+/**
+ * @brief Checks the node budget, and every 1024 nodes the clock and the stop flag.
+ * @return True if the solve must stop.
+ */
+bool EndgameSolver::outOfBudget() {
+    if (this->limits.nodes != 0 && this->nodes >= this->limits.nodes) {
+        return true;
+    }
+    if ((this->nodes & 1023) != 0) {
+        return false;
+    }
+    if (this->limits.stop != nullptr && this->limits.stop->load(std::memory_order_relaxed)) {
+        return true;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - this->startTime;
+    return this->limits.timeMs != 0 &&
+           std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= this->limits.timeMs;
+}
+
+/**
+ * @brief Negamax of the final margin with alpha-beta pruning, lines still running at the horizon counting as
+ * lost for the prover.
+ * A cached result is only reused at the same number of plies to the horizon. One from a deeper horizon would
+ * still bound the margin, but the win it proves may take more plies than are left, and solve reports the horizon
+ * as the length of the win.
+ *
+ * @param board Position to search. Restored before returning.
+ * @param depth Plies left to the horizon.
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
+ * @param prover Side the win is proven for.
+ * @param bestMove Set to the best move if not null.
+ * @return Margin from the point of view of the side to move, or plus or minus UNFINISHED.
+ */
+int EndgameSolver::search(Board& board, int depth, int alpha, int beta, Side prover, Move* bestMove) {
+    this->nodes++;
+    if (this->outOfBudget()) {
+        this->aborted = true;
+        return 0;
+    }
+
+    Side us = board.sideToMove;
+    if (board.isGameOver()) {
+        return board.finalCount(us) - board.finalCount(opponent(us));
+    }
+    if (depth == 0) {
+        return us == prover ? -UNFINISHED : UNFINISHED;
+    }
+
+    uint64_t key = board.hash ^ (prover == Side::Black ? BLACK_PROVER_KEY : 0);
+    CacheEntry& entry = this->cache[key % this->cache.size()];
+    const Move* cacheMove = nullptr;
+    if (entry.key == key && entry.bound != Bound::None) {
+        cacheMove = &entry.move;
+        if (bestMove == nullptr && entry.depth == depth) {
+            if (entry.bound == Bound::Exact ||
+                (entry.bound == Bound::Lower && entry.value >= beta) ||
+                (entry.bound == Bound::Upper && entry.value <= alpha)) {
+                return entry.value;
+            }
+        }
+    }
+
+    MoveList moves;
+    generateSolverMoves(board, moves, us == prover);
+    int scores[MAX_MOVES];
+    scoreMoves(board, moves, scores, cacheMove);
+
+    int originalAlpha = alpha;
+    int best = -UNFINISHED - 1;
+    Move bestLocal;
+    for (int i = 0; i < moves.size(); i++) {
+        for (int j = i + 1; j < moves.size(); j++) {
+            if (scores[j] > scores[i]) {
+                std::swap(scores[i], scores[j]);
+                std::swap(moves[i], moves[j]);
+            }
+        }
+        MoveRecord record;
+        board.makeMove(moves[i], record);
+        int score = -this->search(board, depth - 1, -beta, -alpha, prover, nullptr);
+        board.unmakeMove(record);
+        if (this->aborted) {
+            return 0;
+        }
+        if (score > best) {
+            best = score;
+            bestLocal = moves[i];
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    Bound bound = best <= originalAlpha ? Bound::Upper : best >= beta ? Bound::Lower : Bound::Exact;
+    entry = {key, static_cast<int8_t>(best), static_cast<uint8_t>(depth), bound, bestLocal};
+    if (bestMove != nullptr) {
+        *bestMove = bestLocal;
+    }
+    return best;
+}
+
+/**
+ * @brief Generates moves target by target, which with few empty cells is quicker than walking the pawns.
+ * The prover is restricted to the moves worth trying: every clone, and only jumps that flip more pawns than any
+ * clone. Leaving out some of its own moves can only make a win harder to find, never prove a false one.
+ *
+ * @param board Position to generate moves for.
+ * @param moves List the moves are written to. It is cleared first.
+ * @param restricted True to leave out the jumps no better than a clone.
+ * @return Number of moves, 0 only when the game is over.
+ */
+int EndgameSolver::generateSolverMoves(const Board& board, MoveList& moves, bool restricted) {
+    moves.clear();
+    Bitboard own = board.pieces(board.sideToMove);
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    Bitboard empty = board.empty();
+
+    int bestCloneFlips = -1;
+    for (Bitboard targets = empty; targets.any();) {
+        int to = targets.popLsb();
+        Bitboard sources = ADJACENT_CELLS[to] & own;
+        if (sources.any()) {
+            moves.push({static_cast<uint8_t>(sources.lsb()), static_cast<uint8_t>(to), MoveType::Clone});
+            bestCloneFlips = std::max(bestCloneFlips, (ADJACENT_CELLS[to] & enemy).count());
+        }
+    }
+    for (Bitboard targets = empty; targets.any();) {
+        int to = targets.popLsb();
+        if (restricted && (ADJACENT_CELLS[to] & enemy).count() <= bestCloneFlips) {
+            continue;
+        }
+        for (Bitboard sources = JUMP_CELLS[to] & own; sources.any();) {
+            moves.push({static_cast<uint8_t>(sources.popLsb()), static_cast<uint8_t>(to), MoveType::Jump});
+        }
+    }
+    return moves.size();
+}
+
+/**
+ * @brief Orders moves for the solver: the cached move, then captures, then moves into odd-sized groups of
+ * empty cells.
+ *
+ * @param board Position the moves belong to.
+ * @param moves Moves to score.
+ * @param scores Filled with one score per move, higher first.
+ * @param cacheMove Best move stored for the position, or null.
+ */
+void EndgameSolver::scoreMoves(const Board& board, const MoveList& moves, int* scores, const Move* cacheMove) {
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    Bitboard odd = oddRegions(board.empty());
+    for (int i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+        if (cacheMove != nullptr && move == *cacheMove) {
+            scores[i] = 1000;
+            continue;
+        }
+        int flips = (ADJACENT_CELLS[move.to] & enemy).count();
+        scores[i] = 2 * flips + (odd.test(move.to) ? 1 : 0);
+    }
+}
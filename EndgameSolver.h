@@ -0,0 +1,65 @@
+#include "Board.h"
+#include "Move.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef HEXXAGON_ENDGAMESOLVER_H
+#define HEXXAGON_ENDGAMESOLVER_H
+
+/**
+ * @brief Outcome of a solve. When solved, the side to move can force the game to end within plies plies with a
+ * final point difference of at least margin in its favour, whatever the opponent plays.
+ */
+struct SolverResult {
+    bool solved = false;
+    Move bestMove;
+    int margin = 0;
+    int plies = 0;
+    uint64_t nodes = 0;
+};
+
+/**
+ * @brief Proves forced wins in positions with few empty cells.
+ * Jumps keep the number of empty cells, so a game can go on for ever and there is no exact margin to search for
+ * in general. The solver instead searches to a growing horizon, counting lines still running there as lost for
+ * the side to move. Every margin it finds that way is one that side can force, and the first horizon with a
+ * positive margin gives the quickest forced win.
+ * Results go into a cache of their own, apart from the heuristic transposition table.
+ */
+class EndgameSolver {
+public:
+    explicit EndgameSolver(size_t cacheEntries = 1 << 18);
+
+    SolverResult solve(const Board& board, const SearchLimits& limits);
+    void clear();
+
+private:
+    struct CacheEntry {
+        uint64_t key = 0;
+        int8_t value = 0;
+        uint8_t depth = 0;
+        Bound bound = Bound::None;
+        Move move;
+    };
+
+    std::vector<CacheEntry> cache;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    uint64_t nodes = 0;
+    bool aborted = false;
+
+    bool outOfBudget();
+    int search(Board& board, int depth, int alpha, int beta, Side prover, Move* bestMove);
+    static int generateSolverMoves(const Board& board, MoveList& moves, bool restricted);
+    static void scoreMoves(const Board& board, const MoveList& moves, int* scores, const Move* cacheMove);
+};
+
+Bitboard oddRegions(Bitboard empty);
+
+
+#endif //HEXXAGON_ENDGAMESOLVER_H
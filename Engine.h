@@ -0,0 +1,20 @@
+#include "Board.h"
+#include "Search.h"
+
+#ifndef HEXXAGON_ENGINE_H
+#define HEXXAGON_ENGINE_H
+
+/**
+ * @brief Something that picks a move for a position within search limits.
+ * Lets the computer player switch between alpha-beta and Monte Carlo tree search.
+ */
+class Engine {
+public:
+    virtual ~Engine() = default;
+
+    virtual SearchResult run(const Board& board, const SearchLimits& limits) = 0;
+    virtual int threadCount() const = 0;
+};
+
+
+#endif //HEXXAGON_ENGINE_H
@@ -0,0 +1,112 @@
+#include "Evaluation.h"
+#include "Hex.h"
+
+#include <fstream>
+
+/**
+ * @brief Collects the empty cells a side could move a pawn to.
+ *
+ * @param board Position to look at.
+ * @param side Side whose reach is collected.
+ * @return Mask of empty cells within two steps of a pawn of that side.
+ */
+Bitboard reachableCells(const Board& board, Side side) {
+    return cellsWithinTwo(board.pieces(side)) & board.empty();
+}
+
+/**
+ * @brief Computes the evaluation terms of a position.
+ * Material counts the pawn difference, mobility the difference in empty cells each side can reach.
+ * A pawn is exposed when an empty cell next to it is within the enemy's reach, since a move there flips it.
+ *
+ * @param own Pawns of the side to move.
+ * @param enemy Pawns of the other side.
+ * @return The terms, each in favour of the side to move.
+ */
+EvalFeatures evaluationFeatures(Bitboard own, Bitboard enemy) {
+    Bitboard empty = PLAYABLE & ~(own | enemy);
+    Bitboard ownReach = cellsWithinTwo(own) & empty;
+    Bitboard enemyReach = cellsWithinTwo(enemy) & empty;
+
+    EvalFeatures features;
+    features.material = own.count() - enemy.count();
+    features.mobility = ownReach.count() - enemyReach.count();
+    features.safety = (enemy & adjacentCells(ownReach)).count() - (own & adjacentCells(enemyReach)).count();
+    return features;
+}
+
+/**
+ * @brief Combines the evaluation terms into a score.
+ *
+ * @param features Terms of the position.
+ * @param weights Weights of the terms.
+ * @return Score in hundredths of a pawn.
+ */
+int weighFeatures(const EvalFeatures& features, const EvalWeights& weights) {
+    return weights.material * features.material + weights.mobility * features.mobility +
+           weights.safety * features.safety;
+}
+
+/**
+ * @brief Scores a position from the point of view of the side to move.
+ *
+ * @param board Position to score.
+ * @param weights Weights of the terms.
+ * @return Score in hundredths of a pawn, positive when the side to move is better.
+ */
+int evaluate(const Board& board, const EvalWeights& weights) {
+    Side us = board.sideToMove;
+    return weighFeatures(evaluationFeatures(board.pieces(us), board.pieces(opponent(us))), weights);
+}
+
+/**
+ * @brief Reads weights written by saveEvalWeights, for example by hexx_tune.
+ * After the header line every line holds a term name and its weight. Terms the file leaves out keep their value.
+ *
+ * @param path Path of the weights file.
+ * @param weights Updated only if the whole file is valid.
+ * @return False if the file is missing, has another format version or names an unknown term.
+ */
+bool loadEvalWeights(const std::string& path, EvalWeights& weights) {
+    std::ifstream in(path);
+    std::string header;
+    int version = 0;
+    if (!(in >> header >> version) || header != WEIGHTS_FILE_HEADER || version != WEIGHTS_FORMAT_VERSION) {
+        return false;
+    }
+    EvalWeights loaded = weights;
+    std::string name;
+    int value = 0;
+    while (in >> name >> value) {
+        if (name == "material") {
+            loaded.material = value;
+        } else if (name == "mobility") {
+            loaded.mobility = value;
+        } else if (name == "safety") {
+            loaded.safety = value;
+        } else {
+            return false;
+        }
+    }
+    if (!in.eof()) {
+        return false;
+    }
+    weights = loaded;
+    return true;
+}
+
+/**
+ * @brief Writes weights in the text format loadEvalWeights reads.
+ *
+ * @param path Path of the weights file.
+ * @param weights Weights to write.
+ * @return False if the file could not be written.
+ */
+bool saveEvalWeights(const std::string& path, const EvalWeights& weights) {
+    std::ofstream out(path, std::ios::trunc);
+    out << WEIGHTS_FILE_HEADER << ' ' << WEIGHTS_FORMAT_VERSION << '\n'
+        << "material " << weights.material << '\n'
+        << "mobility " << weights.mobility << '\n'
+        << "safety " << weights.safety << '\n';
+    return out.good();
+}
@@ -0,0 +1,39 @@
+#include "Board.h"
+
+#include <string>
+
+#ifndef HEXXAGON_EVALUATION_H
+#define HEXXAGON_EVALUATION_H
+
+//First line of a weights file, followed by the format version
+constexpr char WEIGHTS_FILE_HEADER[] = "hexx-eval-weights";
+constexpr int WEIGHTS_FORMAT_VERSION = 1;
+
+/**
+ * @brief Weights of the evaluation terms, in hundredths of a pawn.
+ */
+struct EvalWeights {
+    int material = 100;
+    int mobility = 6;
+    int safety = 20;
+};
+
+/**
+ * @brief Terms of the evaluation before weighting, each a difference in favour of the side to move.
+ * safety counts the enemy pawns the side to move could flip next move minus its own pawns the enemy could flip.
+ */
+struct EvalFeatures {
+    int material = 0;
+    int mobility = 0;
+    int safety = 0;
+};
+
+Bitboard reachableCells(const Board& board, Side side);
+EvalFeatures evaluationFeatures(Bitboard own, Bitboard enemy);
+int weighFeatures(const EvalFeatures& features, const EvalWeights& weights);
+int evaluate(const Board& board, const EvalWeights& weights);
+bool loadEvalWeights(const std::string& path, EvalWeights& weights);
+bool saveEvalWeights(const std::string& path, const EvalWeights& weights);
+
+
+#endif //HEXXAGON_EVALUATION_H
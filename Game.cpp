@@ -1,19 +1,46 @@
 #include "Game.h"
 #include "Player.h"
 
+#include <algorithm>
+#include <cmath>
+
+//Triangles per pawn, as many as the points of a default sf::CircleShape
+constexpr int PAWN_SEGMENTS = 30;
+
+//Pawn centre of the cell in column 0, row 0, and the cell spacing used by createBoard and createPawns
+constexpr float FIRST_CENTRE_X = 120;
+constexpr float FIRST_CENTRE_Y = 105;
+constexpr float COLUMN_SPACING = 45;
+constexpr float ROW_SPACING = 50;
+constexpr float ODD_COLUMN_SHIFT = 25;
+//Clicks farther than this from every cell centre miss the board
+constexpr float FIELD_RADIUS = 25;
+
+//Time each move stays on screen during a replay
+constexpr int REPLAY_STEP_MS = 250;
+
+//Plies from the start in which the computer plays from the opening book
+constexpr int BOOK_PLIES = 12;
+
 /**
  * @brief Constructs a Game object.
- * Initializes variables, buttons, window, fields, fonts, and sets the framerate limit to 60.
+ * Initializes variables, buttons, window, fields and fonts.
+ *
+ * @param searchThreads Number of threads the computer player searches with.
+ * @param frameRateLimit Maximum frames per second, at least 1. Frames are only drawn when something changed.
+ * @param hashMegabytes Size of the computer player's transposition table.
  */
-Game::Game() : turnText(this->font), pointText(this->font), startText(this->font), startText1(this->font),
-               gameOverText(this->font), gameOverText1(this->font), startText2(this->font) {
+Game::Game(int searchThreads, unsigned frameRateLimit, size_t hashMegabytes) : transpositionTable(hashMegabytes), searchThreads(searchThreads),
+               bot(std::make_unique<ParallelSearch>(this->transpositionTable, searchThreads)),
+               turnText(this->font), pointText(this->font), startText(this->font), startText1(this->font),
+               startText2(this->font), startText3(this->font), gameOverText(this->font), gameOverText1(this->font),
+               statsText(this->font, "no search yet"), frameRateLimit(std::max(1u, frameRateLimit)) {
     this->initVariables();
     this->initButtons();
     this->initWindow();
     this->initFields();
     this->initFonts();
     this->initBoop();
-    this->gameWindow->setFramerateLimit(60);
 }
 
 /**
@@ -40,21 +67,95 @@ bool Game::getEndGame() const {
     return this->endGame;
 }
 
+/**
+ * @brief Loads the opening book the computer player consults for its first moves.
+ *
+ * @param path Path of a book written by hexx_book.
+ * @return False if the file is missing or not a book.
+ */
+bool Game::loadOpeningBook(const std::string& path) {
+    return this->openingBook.open(path);
+}
+
+/**
+ * @brief Loads evaluation weights, for example ones hexx_tune fitted, and lets the computer player search with them.
+ * A network loaded afterwards keeps these weights for the search's other scores.
+ *
+ * @param path Path of a weights file.
+ * @return False if the file is missing or invalid, in which case the built-in weights stay.
+ */
+bool Game::loadWeights(const std::string& path) {
+    if (!loadEvalWeights(path, this->evalWeights)) {
+        return false;
+    }
+    this->bot.setEngine(std::make_unique<ParallelSearch>(this->transpositionTable, this->searchThreads,
+                                                         this->evalWeights));
+    return true;
+}
+
+/**
+ * @brief Loads a network and lets the computer player's alpha-beta search evaluate with it.
+ *
+ * @param path Path of a network file with this build's format version and layer sizes.
+ * @return False if the file is missing or does not match, in which case the built-in evaluation stays.
+ */
+bool Game::loadNetwork(const std::string& path) {
+    if (!this->network.load(path)) {
+        return false;
+    }
+    this->bot.setEngine(std::make_unique<ParallelSearch>(this->transpositionTable, this->searchThreads, this->evalWeights,
+                                                         &this->network));
+    return true;
+}
+
+/**
+ * @brief Opens the log the statistics of every computer search are appended to, one JSON object per line.
+ *
+ * @param path Path of the log file.
+ * @return False if the file could not be opened.
+ */
+bool Game::openStatsLog(const std::string& path) {
+    this->statsLog.open(path, std::ios::app);
+    return this->statsLog.is_open();
+}
+
 /**
  * @brief Polls events.
- * Handles window close event and the escape key press event to close the game.
+ * Handles window close event and the escape key press event to close the game, the history keys and left clicks.
+ * When nothing is left to draw the thread sleeps until the next event. While the computer is to move or a replay
+ * runs it wakes once per frame instead, because neither the search result nor the replay timer is a window event.
  */
 void Game::pollEvents() {
+    bool idle = !this->needsRedraw;
+    bool ticking = (this->pveChosen && player2.myTurn && !this->endGame) || this->replaying;
+    if (idle && ticking) {
+        sf::sleep(sf::seconds(1.f / static_cast<float>(this->frameRateLimit)));
+    }
+    bool wait = idle && !ticking;
 
     // Event polling
-    while (this->gameWindow->pollEvent(this->ev)) {
+    while (wait ? this->gameWindow->waitEvent(this->ev) : this->gameWindow->pollEvent(this->ev)) {
+        wait = false;
+        if (this->ev.type != sf::Event::MouseMoved) {
+            this->needsRedraw = true;
+        }
         switch (this->ev.type) {
             case sf::Event::Closed:
+                this->bot.cancel();
                 this->gameWindow->close();
                 break;
             case sf::Event::KeyPressed:
-                if (ev.key.code == sf::Keyboard::Escape)
+                if (ev.key.code == sf::Keyboard::Escape) {
+                    this->bot.cancel();
                     this->gameWindow->close();
+                } else {
+                    this->handleKey(ev.key.code);
+                }
+                break;
+            case sf::Event::MouseButtonPressed:
+                if (ev.mouseButton.button == sf::Mouse::Left) {
+                    this->handleClick({ev.mouseButton.x, ev.mouseButton.y});
+                }
                 break;
         }
     }
@@ -63,35 +164,31 @@ void Game::pollEvents() {
 
 /**
  * @brief Creates the game board.
- * Initializes and positions the fields on the board based on their coordinates.
+ * The fields never change, so they are drawn once into a texture that each frame draws with a single sprite.
+ * Holes are left out.
  */
 
 void Game::createBoard() {
+    if (!this->boardLayer.create(this->videoMode.size)) {
+        std::cout << "ERROR: COULDN'T CREATE BOARD TEXTURE" << '\n';
+    }
+    this->boardLayer.clear(sf::Color::Transparent);
+    this->field.setFillColor(sf::Color(189, 134, 68));
+    this->field.setOutlineColor(sf::Color(87, 54, 16));
     for (int y = 0; y < 9; y++) {
         for (int x = 0; x < 9; x++){
+            if (!Board::isPlayable(y * BOARD_SIZE + x)) {
+                continue;
+            }
             if (y % 2) {
                 this->field.setPosition({110 + y * 45.f, 95 + x * 50.f});
             } else {
                 this->field.setPosition({110 + y * 45.f, 70 + x * 50.f});
             }
-            if ((y == 0 && (x == 0 || x == 1 || x == 7 || x == 8)) ||
-                (y == 1 && (x == 0 || x == 7 || x == 8)) ||
-                (y == 2 && (x == 0 || x == 8)) ||
-                (y == 3 && (x == 8 || x == 4)) ||
-                (y == 4 && x == 3) ||
-                (y == 5 && (x == 8 || x == 4)) ||
-                (y == 6 && (x == 0 || x == 8)) ||
-                (y == 7 && (x == 0 || x == 7 || x == 8)) ||
-                (y == 8 && (x == 0 || x == 1 || x == 7 || x == 8))) {
-                this->field.setFillColor(sf::Color::Transparent);
-                this->field.setOutlineColor(sf::Color::Transparent);
-            } else {
-                this->field.setFillColor(sf::Color(189, 134, 68));
-                this->field.setOutlineColor(sf::Color(87, 54, 16));
-            }
-            this->fieldsVec.push_back(this->field);
+            this->boardLayer.draw(this->field);
         }
     }
+    this->boardLayer.display();
 }
 
 /**
@@ -109,15 +206,7 @@ void Game::createPawns() {
             } else {
                 this->playerBase.body.setPosition({105 + y * 45.f, 90 + x * 50.f});
             }
-            if ((y == 0 && (x == 0 || x == 1 || x == 7 || x == 8)) ||
-                (y == 1 && (x == 0 || x == 7 || x == 8)) ||
-                (y == 2 && (x == 0 || x == 8)) ||
-                (y == 3 && (x == 8 || x == 4)) ||
-                (y == 4 && x == 3) ||
-                (y == 5 && (x == 8 || x == 4)) ||
-                (y == 6 && (x == 0 || x == 8)) ||
-                (y == 7 && (x == 0 || x == 7 || x == 8)) ||
-                (y == 8 && (x == 0 || x == 1 || x == 7 || x == 8))) {
+            if (!Board::isPlayable(y * BOARD_SIZE + static_cast<int>(x))) {
                 this->playerBase.body.setFillColor(sf::Color(0, 0, 0, 1));
             } else {
                 this->playerBase.body.setFillColor(sf::Color::Transparent);
@@ -126,10 +215,12 @@ void Game::createPawns() {
             this->playerBase.pawnsVec.push_back(playerBase.body);
         }
     }
-    this->setStartingPawns(44, 74, 2, sf::Color::White);
-    this->setStartingPawns(6, 36, 78, sf::Color::Black);
+    this->board = Board();
+    this->history.clear();
+    this->setStartingPawns(44, 74, 2, Side::White);
+    this->setStartingPawns(6, 36, 78, Side::Black);
     this->setRadiusesForPlayer(player1, 2, sf::Color::Red);
-    this->bodyPos = playerBase.pawnsVec[2].getPosition();
+    this->selectedCell = 2;
     this->setRadiusesForPlayer(player2, 78, sf::Color::Transparent);
     this->player1.myTurn = true;
     this->player2.myTurn = false;
@@ -141,13 +232,13 @@ void Game::createPawns() {
  * @param firstPawn Index of the first pawn.
  * @param secondPawn Index of the second pawn.
  * @param thirdPawn Index of the third pawn.
- * @param pawnColor Color of the pawns.
+ * @param side Owner of the pawns.
  */
 
-void Game::setStartingPawns(int firstPawn, int secondPawn, int thirdPawn, sf::Color pawnColor) {
-    this->playerBase.pawnsVec[firstPawn].setFillColor(pawnColor);
-    this->playerBase.pawnsVec[secondPawn].setFillColor(pawnColor);
-    this->playerBase.pawnsVec[thirdPawn].setFillColor(pawnColor);
+void Game::setStartingPawns(int firstPawn, int secondPawn, int thirdPawn, Side side) {
+    this->board.place(firstPawn, side);
+    this->board.place(secondPawn, side);
+    this->board.place(thirdPawn, side);
 }
 
 /**
@@ -169,394 +260,377 @@ void Game::setRadiusesForPlayer(Player& p, int x, sf::Color radiusColor) {
 }
 
 /**
- * @brief Update the mouse position.
+ * @brief Handle a left click reported by pollEvents.
+ * Picks a mode on the start screen, otherwise passes the clicked cell to the human player whose turn it is.
+ *
+ * @param pixel Click position in window pixels.
  */
 
-void Game::updateMousePos() {
-    this->mousePosWindow = {sf::Mouse::getPosition(*this->gameWindow).x, sf::Mouse::getPosition(*this->gameWindow).y};
-    this->mousePosView = this->gameWindow->mapPixelToCoords(this->mousePosWindow);
+void Game::handleClick(sf::Vector2i pixel) {
+    this->mousePosView = this->gameWindow->mapPixelToCoords(pixel);
+
+    if (!this->pvpChosen && !this->pveChosen) {
+        this->updateStartingWindow();
+        return;
+    }
+    int cell = cellAt(this->mousePosView);
+    if (this->endGame || this->replaying || cell == -1) {
+        return;
+    }
+    if (player1.myTurn) {
+        this->updatePlayerMove(player1, sf::Color::Red, cell);
+    } else if (player2.myTurn && this->pvpChosen) {
+        this->updatePlayerMove(player2, sf::Color::Blue, cell);
+    }
 }
 
 /**
- * @brief Update the game fields.
+ * @brief Handle a key of the move history once a game is on.
+ * Left or Z undoes a move, Right or Y redoes one, Home and End jump to the start and the end of the game,
+ * and R replays the game from the start. Any of them stops a running replay.
+ * S shows or hides the statistics of the computer's last search.
+ *
+ * @param key Pressed key.
  */
 
-void Game::updateFields() {
-    //endgame
-    for (int i = 0; i < playerBase.pawnsVec.size(); i++) {
-        if (playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent) {
-            this->countTransparentPawns++;
-        }
+void Game::handleKey(sf::Keyboard::Key key) {
+    if (!this->pvpChosen && !this->pveChosen) {
+        return;
     }
-    if (this->countTransparentPawns == 0) {
-        this->endGame = true;
-    }
-    this->countTransparentPawns = 0;
-
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-        if (this->mouseHeld == false) {
-            this->mouseHeld = true;
-
-        if (player1.myTurn) {
-
-            for (int i = 0; i < this->playerBase.pawnsVec.size(); i++) {
-                //Set dupe and move radius position for player1
-                if (playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) &&
-                    playerBase.pawnsVec[i].getFillColor() == sf::Color::White) {
-                    this->setRadiusesForPlayer(player1, i, sf::Color::Red);
-                    this->bodyPos = playerBase.pawnsVec[i].getPosition();
-                } else
-                    //Duplicate for player1
-                if (player1.dupeRadius.getOutlineColor() != sf::Color::Transparent && player1.dupeRadius.getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[i].getPosition() != bodyPos) {
-                    this->playerBase.pawnsVec[i].setFillColor(sf::Color::White);
-                    this->setRadiusesForPlayer(player1, i, sf::Color::Transparent);
-                    this->boop.play();
-                    this->countWhitePawns++;
-                    //Capture enemy pawns
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player1.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::Black) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::White);
-                            this->countWhitePawns++;
-                            this->countBlackPawns--;
-                            this->captured = true;
-                        }
-                    }
-                    player2.myTurn = true;
-                    player1.myTurn = false;
-                } else
-                    //Move for player1
-                if (player1.moveRadius.getOutlineColor() != sf::Color::Transparent && player1.moveRadius.getGlobalBounds().contains(this->mousePosView) && !(playerBase.dupeRadius.getGlobalBounds().contains(this->mousePosView)) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent) {
-                    playerBase.pawnsVec[i].setFillColor(sf::Color::White);
-                    this->setRadiusesForPlayer(player1, i, sf::Color::Transparent);
-                    this->boop.play();
-                    //Recolor last used pawn
-                    for (int j = 0; j < playerBase.pawnsVec.size(); ++j) {
-                        if (this->bodyPos == playerBase.pawnsVec[j].getPosition()) {
-                            playerBase.pawnsVec[j].setFillColor(sf::Color::Transparent);
-                        }
-                    }
-                    //Capture enemy pawns
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player1.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::Black) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::White);
-                            this->countWhitePawns++;
-                            this->countBlackPawns--;
-                        }
-                    }
-                    player2.myTurn = true;
-                    player1.myTurn = false;
-                }
-            }
-        }
-
-        } else if (player2.myTurn) {
-
-            for (int i = 0; i < this->playerBase.pawnsVec.size(); i++) {
-                //Set dupe and move radius position for player2
-                if (playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Black) {
-                    this->setRadiusesForPlayer(player2, i, sf::Color::Blue);
-                    bodyPos = playerBase.pawnsVec[i].getPosition();
-                } else
-                //Duplicate for player2
-                if (player2.dupeRadius.getOutlineColor() != sf::Color::Transparent && player2.dupeRadius.getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[i].getPosition() != bodyPos) {
-                    playerBase.pawnsVec[i].setFillColor(sf::Color::Black);
-                    this->setRadiusesForPlayer(player2, i, sf::Color::Transparent);
-                    this->boop.play();
-                    this->countBlackPawns++;
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player2.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::White) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::Black);
-                            this->countBlackPawns++;
-                            this->countWhitePawns--;
-                        }
-                    }
-                    player1.myTurn = true;
-                    player2.myTurn = false;
-                } else
-                //Move for player2
-                if (player2.moveRadius.getOutlineColor() != sf::Color::Transparent && player2.moveRadius.getGlobalBounds().contains(this->mousePosView) && !(playerBase.dupeRadius.getGlobalBounds().contains(this->mousePosView)) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[i].getPosition() != bodyPos) {
-                    playerBase.pawnsVec[i].setFillColor(sf::Color::Black);
-                    this->setRadiusesForPlayer(player2, i, sf::Color::Transparent);
-                    this->boop.play();
-                    //Recolor last used pawn
-                    for (int j = 0; j < playerBase.pawnsVec.size(); ++j) {
-                        if (this->bodyPos == playerBase.pawnsVec[j].getPosition()) {
-                            playerBase.pawnsVec[j].setFillColor(sf::Color::Transparent);
-                        }
-                    }
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player2.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::White) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::Black);
-                            this->countBlackPawns++;
-                            this->countWhitePawns--;
-                        }
-                    }
-                    player1.myTurn = true;
-                    player2.myTurn = false;
-                }
-            }
-
+    switch (key) {
+        case sf::Keyboard::Left:
+        case sf::Keyboard::Z:
+            this->replaying = false;
+            this->stepHistory(-1, true);
+            break;
+        case sf::Keyboard::Right:
+        case sf::Keyboard::Y:
+            this->replaying = false;
+            this->stepHistory(1, true);
+            break;
+        case sf::Keyboard::Home:
+            this->replaying = false;
+            this->stepHistory(-this->history.size(), false);
+            break;
+        case sf::Keyboard::End:
+            this->replaying = false;
+            this->stepHistory(this->history.size(), false);
+            break;
+        case sf::Keyboard::R:
+            this->stepHistory(-this->history.size(), false);
+            this->replaying = this->history.canRedo();
+            this->replayClock.restart();
+            break;
+        case sf::Keyboard::S:
+            this->showStats = !this->showStats;
+            break;
+        default:
+            break;
     }
+}
 
+/**
+ * @brief Move through the history and show the position reached.
+ * A running computer search is cancelled, since its position is gone.
+ *
+ * @param steps Moves to redo, or to undo when negative. Stops early at either end of the history.
+ * @param toHumanTurn Against the computer, also step over the computer's move so the human is to move.
+ */
 
-    } else {
-        this->mouseHeld = false;
+void Game::stepHistory(int steps, bool toHumanTurn) {
+    this->bot.cancel();
+    this->solverNote.clear();
+    bool forward = steps > 0;
+    for (; steps < 0 && this->history.undo(this->board); steps++) {}
+    for (; steps > 0 && this->history.redo(this->board); steps--) {}
+
+    if (toHumanTurn && this->pveChosen && this->board.sideToMove == Side::Black) {
+        forward ? this->history.redo(this->board) : this->history.undo(this->board);
     }
+    this->updateTurn();
+    this->setRadiusesForPlayer(player1, 0, sf::Color::Transparent);
+    this->setRadiusesForPlayer(player2, 0, sf::Color::Transparent);
 }
 
 /**
- * @brief Update the game fields for the bot.
+ * @brief Advance a running replay by one move each REPLAY_STEP_MS.
  */
 
-void Game::updateFieldsBot() {
-    //endgame
-    for (int i = 0; i < playerBase.pawnsVec.size(); i++) {
-        if (playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent) {
-            this->countTransparentPawns++;
-        }
+void Game::updateReplay() {
+    if (this->replayClock.getElapsedTime().asMilliseconds() < REPLAY_STEP_MS) {
+        return;
     }
-    if (this->countTransparentPawns == 0) {
-        this->endGame = true;
-    }
-    this->countTransparentPawns = 0;
-
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-        if (this->mouseHeld == false) {
-            this->mouseHeld = true;
-
-            if (player1.myTurn) {
-
-                for (int i = 0; i < this->playerBase.pawnsVec.size(); i++) {
-                    //Set dupe and move radius position for player1
-                    if (playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) &&
-                        playerBase.pawnsVec[i].getFillColor() == sf::Color::White) {
-                        this->setRadiusesForPlayer(player1, i, sf::Color::Red);
-                        this->bodyPos = playerBase.pawnsVec[i].getPosition();
-                    } else
-                        //Duplicate for player1
-                    if (player1.dupeRadius.getOutlineColor() != sf::Color::Transparent && player1.dupeRadius.getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[i].getPosition() != bodyPos) {
-                        this->playerBase.pawnsVec[i].setFillColor(sf::Color::White);
-                        this->setRadiusesForPlayer(player1, i, sf::Color::Transparent);
-                        this->boop.play();
-                        this->countWhitePawns++;
-                        //Capture enemy pawns
-                        for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                            sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                            if (player1.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::Black) {
-                                playerBase.pawnsVec[c].setFillColor(sf::Color::White);
-                                this->countWhitePawns++;
-                                this->countBlackPawns--;
-                                this->captured = true;
-                            }
-                        }
-                        player2.myTurn = true;
-                        player1.myTurn = false;
-                    } else
-                        //Move for player1
-                    if (player1.moveRadius.getOutlineColor() != sf::Color::Transparent && player1.moveRadius.getGlobalBounds().contains(this->mousePosView) && !(playerBase.dupeRadius.getGlobalBounds().contains(this->mousePosView)) && playerBase.pawnsVec[i].getGlobalBounds().contains(this->mousePosView) && playerBase.pawnsVec[i].getFillColor() == sf::Color::Transparent) {
-                        playerBase.pawnsVec[i].setFillColor(sf::Color::White);
-                        this->setRadiusesForPlayer(player1, i, sf::Color::Transparent);
-                        this->boop.play();
-                        //Recolor last used pawn
-                        for (int j = 0; j < playerBase.pawnsVec.size(); ++j) {
-                            if (this->bodyPos == playerBase.pawnsVec[j].getPosition()) {
-                                playerBase.pawnsVec[j].setFillColor(sf::Color::Transparent);
-                            }
-                        }
-                        //Capture enemy pawns
-                        for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                            sf::Vector2f cPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                            if (player1.dupeRadius.getGlobalBounds().contains(cPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::Black) {
-                                playerBase.pawnsVec[c].setFillColor(sf::Color::White);
-                                this->countWhitePawns++;
-                                this->countBlackPawns--;
-                            }
-                        }
-                        player2.myTurn = true;
-                        player1.myTurn = false;
-                    }
-                }
-            }
-
-        } else if (player2.myTurn) {
-
-            this->moved = false;
-
-
-            //iterate through pawns
-            for (int i = 0; i < playerBase.pawnsVec.size(); ++i) {
-
-                int val = 0;
-                bool taken = false;
-
-                if (playerBase.pawnsVec[i].getFillColor() != sf::Color::Transparent){
-                    taken = true;
-                }
-
-                if (!taken){
-
-                    player2.captureRadius.setPosition({playerBase.pawnsVec[i].getPosition().x - 65, playerBase.pawnsVec[i].getPosition().y - 65});
-
-                    for (int j = 0; j < playerBase.pawnsVec.size(); ++j) {
-                        if (player2.captureRadius.getGlobalBounds().contains({playerBase.pawnsVec[j].getPosition().x + 15, playerBase.pawnsVec[j].getPosition().y + 15}) && playerBase.pawnsVec[j].getFillColor() == sf::Color::White) {
-                            val++;
-
-                        }
-                    }
-                }
-
-                this->pawnValueVec.push_back(val);
-            }
-
-            int maxMoveVal = 0;
-            int maxMoveIndex = 0;
-
-
-            for (int i = 0; i < this->playerBase.pawnsVec.size(); i++) {
-
-                int val = 0;
-
-                if (playerBase.pawnsVec[i].getFillColor() == sf::Color::Black) {
-
-                    setRadiusesForPlayer(player2, i, sf::Color::Transparent);
-
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-
-                        sf::Vector2f pawnPos = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-
-                        if (player2.moveRadius.getGlobalBounds().contains(pawnPos) && playerBase.pawnsVec[c].getFillColor() == sf::Color::Transparent) {
-                            val = pawnValueVec[c];
-                            if (val >= maxMoveVal) {
-                                maxMoveVal = val;
-                                maxMoveIndex = c;
-
-                            }
-                        }
-                    }
-                }
-            }
-
-            for (int i = 0; i < playerBase.pawnsVec.size(); ++i) {
+    this->replayClock.restart();
+    this->stepHistory(1, false);
+    this->replaying = this->history.canRedo();
+}
 
-                setRadiusesForPlayer(player2, i , sf::Color::Transparent);
+/**
+ * @brief Find the cell under a point, straight from the board layout.
+ * The column is rounded from the x coordinate, then the row from the y coordinate of that column and its two
+ * neighbours, since the half-cell shift of odd columns can put the nearest centre one column over.
+ *
+ * @param point Position in view coordinates.
+ * @return Index of the cell whose centre is nearest and within a field radius, or -1 if there is none.
+ */
 
-                if (playerBase.pawnsVec[i].getFillColor() == sf::Color::Black && player2.captureRadius.getGlobalBounds().contains({playerBase.pawnsVec[maxMoveIndex].getPosition().x + 15, playerBase.pawnsVec[maxMoveIndex].getPosition().y + 15})
-                    && playerBase.pawnsVec[maxMoveIndex].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[maxMoveIndex].getFillColor() != sf::Color::White) {
+int Game::cellAt(sf::Vector2f point) {
+    int column = static_cast<int>(std::lround((point.x - FIRST_CENTRE_X) / COLUMN_SPACING));
+    int best = -1;
+    float bestDistance = FIELD_RADIUS * FIELD_RADIUS;
 
-                    playerBase.pawnsVec[maxMoveIndex].setFillColor(sf::Color::Black);
+    for (int c = column - 1; c <= column + 1; c++) {
+        if (c < 0 || c >= BOARD_SIZE) {
+            continue;
+        }
+        float top = FIRST_CENTRE_Y + (c % 2 ? ODD_COLUMN_SHIFT : 0);
+        int row = std::clamp(static_cast<int>(std::lround((point.y - top) / ROW_SPACING)), 0, BOARD_SIZE - 1);
+        float dx = point.x - (FIRST_CENTRE_X + c * COLUMN_SPACING);
+        float dy = point.y - (top + row * ROW_SPACING);
+        if (dx * dx + dy * dy <= bestDistance) {
+            bestDistance = dx * dx + dy * dy;
+            best = c * BOARD_SIZE + row;
+        }
+    }
+    return best;
+}
 
-                    this->countBlackPawns++;
+/**
+ * @brief Update the game fields for the bot.
+ */
 
-                    setRadiusesForPlayer(player2, maxMoveIndex, sf::Color::Transparent);
+void Game::updateFieldsBot() {
+    if (player2.myTurn) {
+        this->updateBotMove();
+    }
+}
 
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos1 = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player2.dupeRadius.getGlobalBounds().contains(cPos1) && playerBase.pawnsVec[c].getFillColor() == sf::Color::White) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::Black);
+/**
+ * @brief Drive the computer player without blocking the frame loop.
+ * Starts a search on the worker thread when the computer gets the turn, and plays its move once the result arrives.
+ * In the first BOOK_PLIES plies a move from the opening book, if there is one, is played at once instead.
+ */
 
-                            this->countBlackPawns++;
-                            this->countWhitePawns--;
-                        }
-                    }
-                    this->moved = true;
-                    player1.myTurn = true;
-                    player2.myTurn = false;
+void Game::updateBotMove() {
+    SearchResult result;
+    if (this->bot.poll(result)) {
+        this->reportSearch(result);
+        SearchStats stats = searchStats(result, this->bot.threadCount());
+        this->statsText.setString(formatSearchStats(stats));
+        if (this->statsLog.is_open()) {
+            this->statsLog << searchStatsJson(stats, this->history.position()) << std::endl;
+        }
+        this->solverNote.clear();
+        if (result.solved) {
+            std::stringstream note;
+            note << "Computer wins by at least " << result.margin << " within " << result.depth << " plies";
+            this->solverNote = note.str();
+        }
+        if (result.hasMove) {
+            this->playMove(result.bestMove);
+            this->setRadiusesForPlayer(player2, result.bestMove.to, sf::Color::Transparent);
+        } else {
+            this->endGame = true;
+            this->needsRedraw = true;
+        }
+    } else if (!this->bot.thinking()) {
+        Move bookMove;
+        if (this->history.position() < BOOK_PLIES && this->openingBook.probe(this->board, this->bookRandom(), bookMove)) {
+            this->playMove(bookMove);
+            this->setRadiusesForPlayer(player2, bookMove.to, sf::Color::Transparent);
+            return;
+        }
+        this->bot.start(this->board, this->botLimits);
+    }
+}
 
-                } else if (playerBase.pawnsVec[i].getFillColor() == sf::Color::Black && !player2.captureRadius.getGlobalBounds().contains({playerBase.pawnsVec[maxMoveIndex].getPosition().x + 15, playerBase.pawnsVec[maxMoveIndex].getPosition().y + 15})
-                           && player2.moveRadius.getGlobalBounds().contains({playerBase.pawnsVec[maxMoveIndex].getPosition().x + 15, playerBase.pawnsVec[maxMoveIndex].getPosition().y + 15}) && playerBase.pawnsVec[maxMoveIndex].getFillColor() == sf::Color::Transparent && playerBase.pawnsVec[maxMoveIndex].getFillColor() != sf::Color::White) {
+/**
+ * @brief Print the statistics of a finished computer search.
+ * Nodes per second and the time each depth was reached show how the search scales with the thread count.
+ * A forced win found by the endgame solver is reported with its margin instead.
+ *
+ * @param result Result of the search.
+ */
 
-                    playerBase.pawnsVec[maxMoveIndex].setFillColor(sf::Color::Black);
-                    playerBase.pawnsVec[i].setFillColor(sf::Color::Transparent);
-                    setRadiusesForPlayer(player2, maxMoveIndex, sf::Color::Transparent);
+void Game::reportSearch(const SearchResult& result) {
+    if (result.solved) {
+        std::cout << "Computer: forced win by at least " << result.margin << " within " << result.depth << " plies, "
+                  << result.nodes << " nodes in " << result.timeMs << " ms" << '\n';
+        return;
+    }
+    uint64_t nps = result.timeMs > 0 ? result.nodes * 1000 / result.timeMs : result.nodes;
+    std::cout << "Computer: depth " << result.depth << ", " << result.nodes << " nodes in " << result.timeMs
+              << " ms, " << nps << " nps, " << this->bot.threadCount() << " threads, depth times (ms):";
+    for (int ms : result.depthTimesMs) {
+        std::cout << ' ' << ms;
+    }
+    std::cout << '\n';
+}
 
-                    for (int c = 0; c < playerBase.pawnsVec.size(); ++c) {
-                        sf::Vector2f cPos1 = {playerBase.pawnsVec[c].getPosition().x + 15, playerBase.pawnsVec[c].getPosition().y + 15};
-                        if (player2.dupeRadius.getGlobalBounds().contains(cPos1) && playerBase.pawnsVec[c].getFillColor() == sf::Color::White) {
-                            playerBase.pawnsVec[c].setFillColor(sf::Color::Black);
+/**
+ * @brief Handle a click of the human player whose turn it is.
+ * Clicking an own pawn selects it, clicking an empty cell in reach of the selected pawn clones or jumps there.
+ *
+ * @param p Player whose turn it is.
+ * @param radiusColor Color of the selection radiuses.
+ * @param cell Index of the clicked cell.
+ */
 
-                            this->countBlackPawns++;
-                            this->countWhitePawns--;
-                        }
-                    }
-                    this->moved = true;
-                    player1.myTurn = true;
-                    player2.myTurn = false;
-                }
-            }
-            if (!moved)
-                this->endGame = true;
+void Game::updatePlayerMove(Player& p, sf::Color radiusColor, int cell) {
+    Piece own = board.sideToMove == Side::White ? Piece::White : Piece::Black;
+
+    //Set dupe and move radius position
+    if (board.at(cell) == own) {
+        this->setRadiusesForPlayer(p, cell, radiusColor);
+        this->selectedCell = cell;
+    } else if (this->selectedCell != -1) {
+        //Duplicate or move
+        Move move = moveBetween(this->selectedCell, cell);
+        if (isLegalMove(this->board, move)) {
+            this->playMove(move);
+            this->setRadiusesForPlayer(p, cell, sf::Color::Transparent);
         }
+    }
+}
 
+/**
+ * @brief Play a move on the board, hand the turn to the other player and check whether the game is over.
+ *
+ * @param move Legal move of the side to move.
+ */
 
-    } else {
-        this->mouseHeld = false;
+void Game::playMove(const Move& move) {
+    if (this->history.play(this->board, move) > 0) {
+        this->captured = true;
     }
+    this->playBoop();
+    this->updateTurn();
+}
+
+/**
+ * @brief Hand the turn to the side to move on the board and check whether the game is over.
+ */
+
+void Game::updateTurn() {
+    this->endGame = this->board.isGameOver();
+    this->needsRedraw = true;
+    this->selectedCell = -1;
+    player1.myTurn = this->board.sideToMove == Side::White;
+    player2.myTurn = this->board.sideToMove == Side::Black;
 }
 /**
  * @brief Updates the game state.
+ * The texts are only rebuilt for frames that will be drawn.
  */
 void Game::update() {
     this->pollEvents();
-    this->updateMousePos();
 
     if (!this->pvpChosen && !this->pveChosen) {
-        this->updateStartingWindow();
-        this->updateStartText();
-    } else if (!this->endGame && this->countBlackPawns != 0 && this->countWhitePawns != 0) {
-        if (this->pvpChosen) {
-            this->updateFields();
+        if (this->needsRedraw) {
+            this->updateStartText();
+        }
+    } else if (!this->endGame) {
+        if (this->replaying) {
+            this->updateReplay();
         } else if (this->pveChosen) {
             this->updateFieldsBot();
         }
-        this->updateText();
-    } else {
+        if (this->needsRedraw) {
+            this->updateText();
+        }
+    } else if (this->needsRedraw) {
         this->updateGameOverText();
     }
 }
 
 /**
  * @brief Renders the game fields.
+ *
+ * @param target Window or texture to draw into.
+ */
+void Game::renderFields(sf::RenderTarget& target) {
+    target.draw(sf::Sprite(this->boardLayer.getTexture()));
+}
+
+/**
+ * @brief Rebuilds the pawn triangles if the pawns moved since the last build.
+ * Each pawn is a fan of triangles around its centre, so all pawns are drawn with one call.
  */
-void Game::renderFields() {
-    for (auto e : this->fieldsVec) {
-        this->gameWindow->draw(e);
+void Game::updatePawnVertices() {
+    if (this->pawnVerticesBuilt && this->drawnWhite == this->board.white && this->drawnBlack == this->board.black) {
+        return;
     }
+    this->pawnVertices.clear();
+
+    float radius = this->playerBase.body.getRadius();
+    for (Bitboard pawns = this->board.occupied(); pawns.any();) {
+        int cell = pawns.popLsb();
+        sf::Vertex vertex;
+        vertex.color = this->board.white.test(cell) ? sf::Color::White : sf::Color::Black;
+        sf::Vector2f centre = this->playerBase.pawnsVec[cell].getPosition() + sf::Vector2f(radius, radius);
+
+        for (int s = 0; s < PAWN_SEGMENTS; s++) {
+            float first = 2 * 3.14159265f * s / PAWN_SEGMENTS;
+            float second = 2 * 3.14159265f * (s + 1) / PAWN_SEGMENTS;
+            vertex.position = centre;
+            this->pawnVertices.append(vertex);
+            vertex.position = centre + sf::Vector2f(radius * std::cos(first), radius * std::sin(first));
+            this->pawnVertices.append(vertex);
+            vertex.position = centre + sf::Vector2f(radius * std::cos(second), radius * std::sin(second));
+            this->pawnVertices.append(vertex);
+        }
+    }
+
+    this->drawnWhite = this->board.white;
+    this->drawnBlack = this->board.black;
+    this->pawnVerticesBuilt = true;
 }
 
 /**
  * @brief Renders the game body.
+ *
+ * @param target Window or texture to draw into.
  */
-void Game::renderBody() {
-    //draw pawns
-    for (auto e : this->playerBase.pawnsVec) {
-        this->gameWindow->draw(e);
-    }
+void Game::renderBody(sf::RenderTarget& target) {
+    //draw pawns from the board state
+    this->updatePawnVertices();
+    target.draw(this->pawnVertices);
 
     //draw radius in which you can move
-    this->gameWindow->draw(this->player1.moveRadius);
-    this->gameWindow->draw(this->player2.moveRadius);
-    this->gameWindow->draw(this->player1.captureRadius);
+    target.draw(this->player1.moveRadius);
+    target.draw(this->player2.moveRadius);
+    target.draw(this->player1.captureRadius);
 
     //draw radius in which body will duplicate
-    this->gameWindow->draw(this->player1.dupeRadius);
-    this->gameWindow->draw(this->player2.dupeRadius);
+    target.draw(this->player1.dupeRadius);
+    target.draw(this->player2.dupeRadius);
 }
 
 /**
- * @brief Renders the game.
+ * @brief Renders the fields and the body of a game in progress, without the text.
+ * Lets hexx_bench time a frame in an offscreen texture.
+ *
+ * @param target Window or texture to draw into.
+ */
+void Game::renderBoard(sf::RenderTarget& target) {
+    this->renderFields(target);
+    this->renderBody(target);
+}
+
+/**
+ * @brief Renders the game, if anything changed since the last frame.
  */
 void Game::render() {
+    if (!this->needsRedraw) {
+        return;
+    }
+    this->needsRedraw = false;
     this->gameWindow->clear(sf::Color(135, 85, 46));
     if (!this->pvpChosen && !this->pveChosen) {
         this->renderButtons();
         this->renderStartText();
-    } else if (!this->endGame && this->countBlackPawns != 0 && this->countWhitePawns != 0) {
-        this->renderFields();
-        this->renderBody();
+    } else if (!this->endGame) {
+        this->renderBoard(*this->gameWindow);
         this->renderText();
     } else {
         this->renderGameOverText();
@@ -579,6 +653,12 @@ void Game::initButtons() {
     this->button1.setOutlineColor(sf::Color(87, 54, 16));
     this->button1.setOutlineThickness(3);
     this->button1.setPosition({150, 380});
+
+    this->button2.setSize({300, 60});
+    this->button2.setFillColor(sf::Color(189, 134, 68));
+    this->button2.setOutlineColor(sf::Color(87, 54, 16));
+    this->button2.setOutlineThickness(3);
+    this->button2.setPosition({150, 460});
 }
 
 /**
@@ -589,8 +669,11 @@ void Game::initVariables() {
     this->ev;
 
     //Game logic
-    this->mouseHeld = false;
     this->endGame = false;
+
+    //Computer player
+    this->botLimits.depth = MAX_PLY;
+    this->botLimits.timeMs = 500;
 }
 
 /**
@@ -599,7 +682,7 @@ void Game::initVariables() {
 void Game::initWindow() {
     this->videoMode.size = {600, 700};
     this->gameWindow= new sf::RenderWindow(this->videoMode, "HEXXAGON", sf::Style::Close | sf::Style::Titlebar);
-    this->gameWindow->setFramerateLimit(120);
+    this->gameWindow->setFramerateLimit(this->frameRateLimit);
 }
 
 /**
@@ -618,7 +701,7 @@ void Game::initFields() {
  * @brief Initializes the fonts.
  */
 void Game::initFonts() {
-    if (!this->font.loadFromFile("Fonts/monogram.ttf")) {
+    if (!loadFont(this->font, Asset::Font)) {
         std::cout << "ERROR: COULDN'T LOAD FONT" << '\n';
     }
 }
@@ -638,19 +721,34 @@ void Game::updateText() {
     }
 
     std::stringstream ss;
-    ss << "White player's points: " << this->countWhitePawns << "        Black player's points: " << this->countBlackPawns;
+    ss << "White player's points: " << this->board.count(Side::White) << "        Black player's points: " << this->board.count(Side::Black);
+    if (!this->solverNote.empty()) {
+        ss << '\n' << this->solverNote;
+    }
     this->pointText.setPosition({20, 630});
     this->pointText.setString(ss.str());
     this->pointText.setCharacterSize(27);
     this->pointText.setFillColor(sf::Color::Black);
+
+    this->statsText.setPosition({400, 70});
+    this->statsText.setCharacterSize(18);
+    this->statsText.setFillColor(sf::Color::White);
+    sf::FloatRect bounds = this->statsText.getGlobalBounds();
+    this->statsBackground.setPosition(bounds.position - sf::Vector2f(6, 6));
+    this->statsBackground.setSize(bounds.size + sf::Vector2f(12, 12));
+    this->statsBackground.setFillColor(sf::Color(0, 0, 0, 160));
 }
 
 /**
- * @brief Renders the text in the game.
+ * @brief Renders the text in the game, and the statistics overlay while it is shown.
  */
 void Game::renderText() {
     this->gameWindow->draw(this->turnText);
     this->gameWindow->draw(this->pointText);
+    if (this->showStats) {
+        this->gameWindow->draw(this->statsBackground);
+        this->gameWindow->draw(this->statsText);
+    }
 }
 
 /**
@@ -660,6 +758,7 @@ void Game::renderStartText() {
     this->gameWindow->draw(startText);
     this->gameWindow->draw(startText1);
     this->gameWindow->draw(startText2);
+    this->gameWindow->draw(startText3);
 }
 
 /**
@@ -680,15 +779,23 @@ void Game::updateStartText() {
     this->startText2.setFillColor(sf::Color::Black);
     this->startText2.setCharacterSize(30);
     this->startText2.setPosition({206, 387});
+
+    this->startText3.setString("Player vs MCTS");
+    this->startText3.setFillColor(sf::Color::Black);
+    this->startText3.setCharacterSize(30);
+    this->startText3.setPosition({228, 467});
 }
 
 /**
- * @brief Updates the starting window.
+ * @brief Updates the starting window after a click at mousePosView.
  */
 void Game::updateStartingWindow() {
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Left) && this->button.getGlobalBounds().contains(this->mousePosView)) {
+    if (this->button.getGlobalBounds().contains(this->mousePosView)) {
         this->pvpChosen = true;
-    } else if (sf::Mouse::isButtonPressed(sf::Mouse::Left) && this->button1.getGlobalBounds().contains(this->mousePosView)) {
+    } else if (this->button1.getGlobalBounds().contains(this->mousePosView)) {
+        this->pveChosen = true;
+    } else if (this->button2.getGlobalBounds().contains(this->mousePosView)) {
+        this->bot.setEngine(std::make_unique<Mcts>(this->searchThreads, this->evalWeights));
         this->pveChosen = true;
     }
 }
@@ -699,16 +806,35 @@ void Game::updateStartingWindow() {
 void Game::renderButtons() {
     this->gameWindow->draw(this->button);
     this->gameWindow->draw(this->button1);
+    this->gameWindow->draw(this->button2);
 }
 
 /**
- * @brief Initializes the boop sound.
+ * @brief Starts decoding the boop sound on a worker thread, so the first frame does not wait for it.
  */
 void Game::initBoop() {
-    if (!this->soundBuffer.loadFromFile("Music\\realBoop.wav")) {
-        std::cout << "ERROR: COULDN'T LOAD SOUND" << '\n';
+    this->boopLoading = std::async(std::launch::async, [this]() {
+        return loadSoundBuffer(this->soundBuffer, Asset::Boop);
+    });
+}
+
+/**
+ * @brief Plays the boop sound, or nothing if it is still being decoded.
+ * The first call after decoding finished hands the buffer to the sound.
+ */
+void Game::playBoop() {
+    if (this->boopLoading.valid() &&
+        this->boopLoading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        if (this->boopLoading.get()) {
+            this->boop.setBuffer(this->soundBuffer);
+            this->boopLoaded = true;
+        } else {
+            std::cout << "ERROR: COULDN'T LOAD SOUND" << '\n';
+        }
+    }
+    if (this->boopLoaded) {
+        this->boop.play();
     }
-    this->boop.setBuffer(soundBuffer);
 }
 
 /**
@@ -721,11 +847,13 @@ void Game::updateGameOverText() {
     this->gameOverText.setPosition({140, 150});
 
     std::string winner;
+    int whitePoints = this->board.finalCount(Side::White);
+    int blackPoints = this->board.finalCount(Side::Black);
 
-    if (countWhitePawns > countBlackPawns) {
+    if (whitePoints > blackPoints) {
         winner = "White player wins!!";
         this->gameOverText1.setFillColor(sf::Color::White);
-    } else if (countWhitePawns < countBlackPawns) {
+    } else if (whitePoints < blackPoints) {
         winner = "Black player wins!!";
         this->gameOverText1.setFillColor(sf::Color::Black);
     } else {
@@ -734,7 +862,8 @@ void Game::updateGameOverText() {
     }
 
     std::stringstream ss;
-    ss << "White player's points: " << this->countWhitePawns << "    " << "Black player's points: " << this->countBlackPawns << '\n' << '\n' << "                 " << winner;
+    ss << "White player's points: " << whitePoints << "    " << "Black player's points: " << blackPoints << '\n' << '\n' << "                 " << winner
+       << '\n' << '\n' << '\n' << "        Left: undo    R: replay";
     this->gameOverText1.setString(ss.str());
     this->gameOverText1.setCharacterSize(27);
     this->gameOverText1.setPosition({40, 280});
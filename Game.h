@@ -2,12 +2,24 @@
 #include "SFML/System.hpp"
 #include "SFML/Window.hpp"
 #include "SFML/Audio.hpp"
-#include "SFML/Network.hpp"
 #include "Player.h"
-
+#include "Assets.h"
+#include "Board.h"
+#include "Hex.h"
+#include "MoveGen.h"
+#include "MoveHistory.h"
+#include "OpeningBook.h"
+#include "AsyncSearch.h"
+#include "Mcts.h"
+#include "ParallelSearch.h"
+#include "SearchStats.h"
+
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <vector>
 #include <ctime>
+#include <random>
 #include <sstream>
 
 #ifndef HEXXAGON_GAME_H
@@ -21,32 +33,41 @@ private:
     sf::VideoMode videoMode;
     sf::Event ev{};
 
-    //Mouse position
-    sf::Vector2i mousePosWindow;
+    //Position of the last click
     sf::Vector2f mousePosView;
 
     //Resources
     Player playerBase;
     Player player1;
     Player player2;
-    sf::Vector2f bodyPos;
-    int countTransparentPawns = 0;
-    int countWhitePawns = 3;
-    int countBlackPawns = 3;
+    Board board;
+    MoveHistory history;
+    int selectedCell = -1;
     bool endgame = false;
     bool pvpChosen = false;
     bool pveChosen = false;
     sf::RectangleShape button;
     sf::RectangleShape button1;
+    sf::RectangleShape button2;
     bool captured = false;
-    bool moved = false;
-    std::vector<int> pawnValueVec;
+    TranspositionTable transpositionTable;
+    int searchThreads;
+    EvalWeights evalWeights;
+    NnueNetwork network;
+    AsyncSearch bot;
+    SearchLimits botLimits;
+    OpeningBook openingBook;
+    std::mt19937_64 bookRandom{std::random_device{}()};
+    std::ofstream statsLog;
 
     //Sounds
     sf::SoundBuffer soundBuffer;
     sf::Sound boop;
     sf::SoundBuffer soundBuffer1;
     sf::Sound money;
+    //Decodes soundBuffer on a worker thread, boop gets it once the result is taken
+    std::future<bool> boopLoading;
+    bool boopLoaded = false;
 
     //Text
     sf::Font font;
@@ -55,18 +76,30 @@ private:
     sf::Text startText;
     sf::Text startText1;
     sf::Text startText2;
+    sf::Text startText3;
     sf::Text gameOverText;
     sf::Text gameOverText1;
+    sf::Text statsText;
+    sf::RectangleShape statsBackground;
 
 
     //Game logic
-    bool mouseHeld{};
     bool endGame{};
+    bool needsRedraw = true;
+    bool replaying = false;
+    sf::Clock replayClock;
+    std::string solverNote;
+    bool showStats = false;
+    unsigned frameRateLimit;
 
     //Game objects
-    std::vector<sf::CircleShape> fieldsVec;
     sf::CircleShape field;
     sf::CircleShape toDelete;
+    sf::RenderTexture boardLayer;
+    sf::VertexArray pawnVertices{sf::PrimitiveType::Triangles};
+    Bitboard drawnWhite;
+    Bitboard drawnBlack;
+    bool pawnVerticesBuilt = false;
 
     //Private functions
     void initButtons();
@@ -75,11 +108,12 @@ private:
     void initFields();
     void initFonts();
     void initBoop();
+    void playBoop();
 
 public:
     sf::RenderWindow* gameWindow{};
     //Constructors / Destructors
-    Game();
+    explicit Game(int searchThreads = 1, unsigned frameRateLimit = 60, size_t hashMegabytes = 64);
     virtual ~Game();
 
     //Accessors
@@ -87,20 +121,34 @@ public:
     bool getEndGame() const;
 
     //Functions
+    bool loadOpeningBook(const std::string& path);
+    bool loadWeights(const std::string& path);
+    bool loadNetwork(const std::string& path);
+    bool openStatsLog(const std::string& path);
     void createBoard();
     void createPawns();
     void pollEvents();
     void updateStartingWindow();
-    void updateMousePos();
-    void setStartingPawns(int firstPawn, int secondPawn, int thirdPawn, sf::Color pawnColor);
+    void handleClick(sf::Vector2i pixel);
+    void handleKey(sf::Keyboard::Key key);
+    void stepHistory(int steps, bool toHumanTurn);
+    void updateReplay();
+    static int cellAt(sf::Vector2f point);
+    void setStartingPawns(int firstPawn, int secondPawn, int thirdPawn, Side side);
     void setRadiusesForPlayer(Player& p, int x, sf::Color radiusColor);
-    void updateFields();
     void updateFieldsBot();
+    void updateBotMove();
+    void reportSearch(const SearchResult& result);
+    void updatePlayerMove(Player& p, sf::Color radiusColor, int cell);
+    void playMove(const Move& move);
+    void updateTurn();
     void updateText();
     void update();
     void renderButtons();
-    void renderFields();
-    void renderBody();
+    void renderFields(sf::RenderTarget& target);
+    void updatePawnVertices();
+    void renderBody(sf::RenderTarget& target);
+    void renderBoard(sf::RenderTarget& target);
     void renderText();
     void renderStartText();
     void updateStartText();
@@ -0,0 +1,196 @@
+#include "GameRecord.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+
+/**
+ * @brief Appends an unsigned value in little-endian byte order.
+ *
+ * @param out Buffer to append to.
+ * @param value Value to write.
+ * @param bytes Number of bytes to write.
+ */
+static void putLittleEndian(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Reads an unsigned value stored in little-endian byte order.
+ *
+ * @param data First byte of the value.
+ * @param bytes Number of bytes to read.
+ */
+static uint64_t getLittleEndian(const uint8_t* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Checks the magic and format version at the start of a file.
+ *
+ * @param data First bytes of the file.
+ * @param size Number of bytes available.
+ * @param magic Expected magic.
+ */
+bool validFileHeader(const uint8_t* data, size_t size, const char* magic) {
+    return size >= FILE_HEADER_SIZE && std::equal(magic, magic + 4, data) && data[4] == RECORD_FORMAT_VERSION;
+}
+
+/**
+ * @brief Finds a move in the generated list. Clones to the same cell give the same position, so their source
+ * does not have to match.
+ *
+ * @param moves Generated moves.
+ * @param move Move to find.
+ * @return Index of the move, or -1 if it is not legal.
+ */
+static int moveOrdinal(const MoveList& moves, const Move& move) {
+    for (int i = 0; i < moves.size(); i++) {
+        if (moves[i].to == move.to && moves[i].type == move.type &&
+            (move.type == MoveType::Clone || moves[i].from == move.from)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Encodes the moves of a game from the starting position, about one byte per move.
+ * A move is stored as its index in the generateMoves list of its position. The rare move past index 254 is
+ * written as MOVE_ESCAPE followed by its source and its target, with the top bit set for a jump.
+ *
+ * @param moves Legal moves played from the starting position.
+ * @param out Buffer the bytes are appended to.
+ * @return False if a move was not legal in its position.
+ */
+bool encodeMoves(const std::vector<Move>& moves, std::vector<uint8_t>& out) {
+    Board board = Board::startingPosition();
+    MoveList list;
+    for (const Move& move : moves) {
+        generateMoves(board, list);
+        int ordinal = moveOrdinal(list, move);
+        if (ordinal < 0) {
+            return false;
+        }
+        if (ordinal < MOVE_ESCAPE) {
+            out.push_back(static_cast<uint8_t>(ordinal));
+        } else {
+            out.push_back(MOVE_ESCAPE);
+            out.push_back(move.from);
+            out.push_back(static_cast<uint8_t>(move.to | (move.type == MoveType::Jump ? 0x80 : 0)));
+        }
+        MoveRecord record;
+        board.makeMove(list[ordinal], record);
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes moves written by encodeMoves.
+ *
+ * @param data First encoded byte.
+ * @param size Number of encoded bytes.
+ * @param plies Number of moves to decode.
+ * @param moves Filled with the moves, as generateMoves lists them.
+ * @return False if the bytes do not describe legal moves.
+ */
+bool decodeMoves(const uint8_t* data, size_t size, int plies, std::vector<Move>& moves) {
+    Board board = Board::startingPosition();
+    MoveList list;
+    moves.clear();
+    size_t pos = 0;
+    for (int ply = 0; ply < plies; ply++) {
+        if (pos >= size) {
+            return false;
+        }
+        Move move;
+        if (data[pos] != MOVE_ESCAPE) {
+            generateMoves(board, list);
+            if (data[pos] >= list.size()) {
+                return false;
+            }
+            move = list[data[pos]];
+            pos++;
+        } else {
+            if (pos + 3 > size) {
+                return false;
+            }
+            move = {data[pos + 1], static_cast<uint8_t>(data[pos + 2] & 0x7F),
+                    (data[pos + 2] & 0x80) ? MoveType::Jump : MoveType::Clone};
+            if (move.from >= CELL_COUNT || move.to >= CELL_COUNT || !isLegalMove(board, move)) {
+                return false;
+            }
+            pos += 3;
+        }
+        MoveRecord record;
+        board.makeMove(move, record);
+        moves.push_back(move);
+    }
+    return pos == size;
+}
+
+/**
+ * @brief Encodes a whole game: the fixed header, the engine descriptions and the moves.
+ * Header layout, little-endian: move bytes (4), plies (2), white points (1), black points (1), timestamp (8).
+ * Then the white and the black engine, each a length byte followed by that many bytes. Engine descriptions longer
+ * than MAX_ENGINE_NAME_SIZE bytes are cut.
+ *
+ * @param record Game to encode.
+ * @param out Buffer the bytes are appended to.
+ * @return False if a move was not legal or the game has more than 65535 moves.
+ */
+bool encodeGameRecord(const GameRecord& record, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> moveBytes;
+    if (record.moves.size() > 0xFFFF || !encodeMoves(record.moves, moveBytes)) {
+        return false;
+    }
+    putLittleEndian(out, moveBytes.size(), 4);
+    putLittleEndian(out, record.moves.size(), 2);
+    putLittleEndian(out, static_cast<uint64_t>(record.whitePoints), 1);
+    putLittleEndian(out, static_cast<uint64_t>(record.blackPoints), 1);
+    putLittleEndian(out, static_cast<uint64_t>(record.timestamp), 8);
+    for (const std::string* engine : {&record.whiteEngine, &record.blackEngine}) {
+        size_t length = std::min(engine->size(), MAX_ENGINE_NAME_SIZE);
+        out.push_back(static_cast<uint8_t>(length));
+        out.insert(out.end(), engine->begin(), engine->begin() + static_cast<std::ptrdiff_t>(length));
+    }
+    out.insert(out.end(), moveBytes.begin(), moveBytes.end());
+    return true;
+}
+
+/**
+ * @brief Decodes one game written by encodeGameRecord.
+ *
+ * @param data First byte of the game.
+ * @param size Number of bytes available from there on.
+ * @param record Filled with the game.
+ * @return Number of bytes the game takes, or 0 if the data is truncated or invalid.
+ */
+size_t decodeGameRecord(const uint8_t* data, size_t size, GameRecord& record) {
+    if (size < RECORD_HEADER_SIZE) {
+        return 0;
+    }
+    size_t moveBytes = getLittleEndian(data, 4);
+    int plies = static_cast<int>(getLittleEndian(data + 4, 2));
+    record.whitePoints = data[6];
+    record.blackPoints = data[7];
+    record.timestamp = static_cast<int64_t>(getLittleEndian(data + 8, 8));
+    size_t pos = RECORD_HEADER_SIZE;
+    for (std::string* engine : {&record.whiteEngine, &record.blackEngine}) {
+        if (pos >= size || data[pos] > size - pos - 1) {
+            return 0;
+        }
+        const char* name = reinterpret_cast<const char*>(data + pos + 1);
+        engine->assign(name, data[pos]);
+        pos += 1 + data[pos];
+    }
+    if (moveBytes > size - pos || !decodeMoves(data + pos, moveBytes, plies, record.moves)) {
+        return 0;
+    }
+    return pos + moveBytes;
+}
@@ -0,0 +1,42 @@
+#include "Board.h"
+#include "Move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef HEXXAGON_GAMERECORD_H
+#define HEXXAGON_GAMERECORD_H
+
+//Every file starts with a 4-byte magic and a 4-byte format version
+constexpr char RECORD_FILE_MAGIC[4] = {'H', 'X', 'G', 'R'};
+constexpr char INDEX_FILE_MAGIC[4] = {'H', 'X', 'G', 'I'};
+constexpr uint32_t RECORD_FORMAT_VERSION = 2;
+constexpr size_t FILE_HEADER_SIZE = 8;
+//Fixed part of every game: sizes, final points and timestamp. The engine descriptions follow, each after its length.
+constexpr size_t RECORD_HEADER_SIZE = 16;
+constexpr size_t MAX_ENGINE_NAME_SIZE = 255;
+//Move byte announcing a move written out in full, for positions with more moves than fit in a byte
+constexpr uint8_t MOVE_ESCAPE = 255;
+
+/**
+ * @brief One finished game, played from Board::startingPosition, the setup Game::createPawns shows.
+ */
+struct GameRecord {
+    std::vector<Move> moves;
+    int whitePoints = 0;
+    int blackPoints = 0;
+    int64_t timestamp = 0;
+    std::string whiteEngine;
+    std::string blackEngine;
+};
+
+bool validFileHeader(const uint8_t* data, size_t size, const char* magic);
+bool encodeMoves(const std::vector<Move>& moves, std::vector<uint8_t>& out);
+bool decodeMoves(const uint8_t* data, size_t size, int plies, std::vector<Move>& moves);
+bool encodeGameRecord(const GameRecord& record, std::vector<uint8_t>& out);
+size_t decodeGameRecord(const uint8_t* data, size_t size, GameRecord& record);
+
+
+#endif //HEXXAGON_GAMERECORD_H
@@ -0,0 +1,78 @@
+#include "GameRecordReader.h"
+#include "GameRecordWriter.h"
+
+#include <algorithm>
+
+/**
+ * @brief Maps a record file and, if there is one, its index file. Reading starts at the first game.
+ *
+ * @param path Path of the record file.
+ * @return False if the record file is missing or not a record file.
+ */
+bool GameRecordReader::open(const std::string& path) {
+    if (!this->data.open(path) || !validFileHeader(this->data.data(), this->data.size(), RECORD_FILE_MAGIC)) {
+        this->data.close();
+        return false;
+    }
+    if (this->index.open(GameRecordWriter::indexPath(path)) &&
+        !validFileHeader(this->index.data(), this->index.size(), INDEX_FILE_MAGIC)) {
+        this->index.close();
+    }
+    this->offset = FILE_HEADER_SIZE;
+    return true;
+}
+
+/**
+ * @brief Reads the next game.
+ *
+ * @param record Filled with the game.
+ * @return False at the end of the file, or if the rest of the file is damaged.
+ */
+bool GameRecordReader::next(GameRecord& record) {
+    if (!this->data.isOpen() || this->offset >= this->data.size()) {
+        return false;
+    }
+    size_t used = decodeGameRecord(this->data.data() + this->offset, this->data.size() - this->offset, record);
+    if (used == 0) {
+        this->offset = this->data.size();
+        return false;
+    }
+    this->offset += used;
+    return true;
+}
+
+/**
+ * @brief Moves to a game by its number in constant time, using the index file.
+ *
+ * @param game Number of the game, counting from 0.
+ * @return False if there is no index or no such game.
+ */
+bool GameRecordReader::seek(uint64_t game) {
+    if (game >= this->indexedGames()) {
+        return false;
+    }
+    const uint8_t* entry = this->index.data() + FILE_HEADER_SIZE + game * 8;
+    uint64_t position = 0;
+    for (int i = 0; i < 8; i++) {
+        position |= static_cast<uint64_t>(entry[i]) << (8 * i);
+    }
+    if (position < FILE_HEADER_SIZE || position >= this->data.size()) {
+        return false;
+    }
+    this->offset = static_cast<size_t>(position);
+    return true;
+}
+
+/**
+ * @brief Tells whether an index file was found next to the record file.
+ */
+bool GameRecordReader::hasIndex() const {
+    return this->index.isOpen();
+}
+
+/**
+ * @brief Retrieves the number of games in the index file.
+ */
+uint64_t GameRecordReader::indexedGames() const {
+    return this->hasIndex() ? (this->index.size() - FILE_HEADER_SIZE) / 8 : 0;
+}
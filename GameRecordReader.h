@@ -0,0 +1,29 @@
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef HEXXAGON_GAMERECORDREADER_H
+#define HEXXAGON_GAMERECORDREADER_H
+
+/**
+ * @brief Reads games from a memory-mapped record file, in order or, with an index file, by number.
+ */
+class GameRecordReader {
+public:
+    bool open(const std::string& path);
+    bool next(GameRecord& record);
+    bool seek(uint64_t game);
+    bool hasIndex() const;
+    uint64_t indexedGames() const;
+
+private:
+    MappedFile data;
+    MappedFile index;
+    size_t offset = 0;
+};
+
+
+#endif //HEXXAGON_GAMERECORDREADER_H
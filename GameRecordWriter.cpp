@@ -0,0 +1,145 @@
+#include "GameRecordWriter.h"
+#include "MappedFile.h"
+
+#include <filesystem>
+#include <system_error>
+
+/**
+ * @brief Writes the magic and format version at the start of a new file.
+ *
+ * @param file File opened for appending.
+ * @param magic Magic of the file type.
+ */
+static void writeFileHeader(std::ofstream& file, const char* magic) {
+    char header[FILE_HEADER_SIZE] = {magic[0], magic[1], magic[2], magic[3],
+                                     static_cast<char>(RECORD_FORMAT_VERSION), 0, 0, 0};
+    file.write(header, FILE_HEADER_SIZE);
+}
+
+/**
+ * @brief Checks that an existing file starts with the magic and format version, before anything is appended to it.
+ *
+ * @param path Path of the file.
+ * @param magic Expected magic.
+ */
+static bool hasFileHeader(const std::string& path, const char* magic) {
+    std::ifstream file(path, std::ios::binary);
+    uint8_t header[FILE_HEADER_SIZE] = {};
+    file.read(reinterpret_cast<char*>(header), FILE_HEADER_SIZE);
+    return validFileHeader(header, static_cast<size_t>(file.gcount()), magic);
+}
+
+/**
+ * @brief Appends a game offset to an index file.
+ *
+ * @param index Index file opened for appending.
+ * @param offset Offset of the game in the record file.
+ */
+static void writeIndexEntry(std::ofstream& index, uint64_t offset) {
+    char entry[8];
+    for (int i = 0; i < 8; i++) {
+        entry[i] = static_cast<char>(offset >> (8 * i));
+    }
+    index.write(entry, sizeof(entry));
+}
+
+/**
+ * @brief Writes the offsets of the games already in a record file to a new index.
+ *
+ * @param path Path of the record file.
+ * @param end Size of the record file.
+ * @param index New index file, its header already written.
+ * @return False if the record file could not be read or a game in it is damaged.
+ */
+static bool indexExistingGames(const std::string& path, uint64_t end, std::ofstream& index) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < end) {
+        return false;
+    }
+    GameRecord record;
+    for (uint64_t offset = FILE_HEADER_SIZE; offset < end;) {
+        size_t used = decodeGameRecord(file.data() + offset, end - offset, record);
+        if (used == 0) {
+            return false;
+        }
+        writeIndexEntry(index, offset);
+        offset += used;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a record file for appending, creating it if needed.
+ * An index missing next to a record file that already holds games is rebuilt from them. If one of them is damaged,
+ * the index is not opened and isOpen reports false. So it does if an existing record or index file does not start
+ * with the magic and format version of its type: nothing is ever appended to another kind of file.
+ *
+ * @param path Path of the record file.
+ * @param writeIndex Also append the offset of every game to the file indexPath(path).
+ */
+GameRecordWriter::GameRecordWriter(const std::string& path, bool writeIndex) : writeIndex(writeIndex) {
+    std::error_code error;
+    uint64_t existing = std::filesystem::exists(path, error) ? std::filesystem::file_size(path, error) : 0;
+    if (existing > 0 && !hasFileHeader(path, RECORD_FILE_MAGIC)) {
+        return;
+    }
+    this->data.open(path, std::ios::binary | std::ios::app);
+    if (existing == 0) {
+        writeFileHeader(this->data, RECORD_FILE_MAGIC);
+        existing = FILE_HEADER_SIZE;
+    }
+    this->offset = existing;
+
+    if (writeIndex) {
+        std::string index = indexPath(path);
+        bool fresh = !std::filesystem::exists(index, error) || std::filesystem::file_size(index, error) == 0;
+        if (!fresh && !hasFileHeader(index, INDEX_FILE_MAGIC)) {
+            return;
+        }
+        this->index.open(index, std::ios::binary | std::ios::app);
+        if (fresh) {
+            writeFileHeader(this->index, INDEX_FILE_MAGIC);
+            if (this->offset > FILE_HEADER_SIZE && !indexExistingGames(path, this->offset, this->index)) {
+                this->index.close();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tells whether the files could be opened.
+ */
+bool GameRecordWriter::isOpen() const {
+    return this->data.is_open() && (!this->writeIndex || this->index.is_open());
+}
+
+/**
+ * @brief Encodes a game and appends it. Safe to call from several threads.
+ *
+ * @param record Game to append.
+ * @return False if the game could not be encoded or written.
+ */
+bool GameRecordWriter::append(const GameRecord& record) {
+    std::vector<uint8_t> bytes;
+    if (!encodeGameRecord(record, bytes)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->writeIndex) {
+        writeIndexEntry(this->index, this->offset);
+        this->index.flush();
+    }
+    this->data.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    this->data.flush();
+    this->offset += bytes.size();
+    return this->data.good() && (!this->writeIndex || this->index.good());
+}
+
+/**
+ * @brief Retrieves the path of the index file that goes with a record file.
+ * @param path Path of the record file.
+ */
+std::string GameRecordWriter::indexPath(const std::string& path) {
+    return path + ".idx";
+}
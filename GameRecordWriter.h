@@ -0,0 +1,33 @@
+#include "GameRecord.h"
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#ifndef HEXXAGON_GAMERECORDWRITER_H
+#define HEXXAGON_GAMERECORDWRITER_H
+
+/**
+ * @brief Appends games to a record file, and their offsets to an index file next to it.
+ * Any number of threads may append at once. Games are encoded before the lock is taken, so the lock only
+ * covers the file writes.
+ */
+class GameRecordWriter {
+public:
+    explicit GameRecordWriter(const std::string& path, bool writeIndex = true);
+
+    bool isOpen() const;
+    bool append(const GameRecord& record);
+    static std::string indexPath(const std::string& path);
+
+private:
+    std::mutex mutex;
+    std::ofstream data;
+    std::ofstream index;
+    uint64_t offset = 0;
+    bool writeIndex;
+};
+
+
+#endif //HEXXAGON_GAMERECORDWRITER_H
@@ -0,0 +1,123 @@
+#include "Bitboard.h"
+#include "Board.h"
+
+#include <array>
+
+#ifndef HEXXAGON_HEX_H
+#define HEXXAGON_HEX_H
+
+/**
+ * @brief Hex distance between two cells of the 9x9 layout.
+ * Odd columns are drawn half a cell lower, so rows are converted to axial coordinates first.
+ * @param a Index of the first cell.
+ * @param b Index of the second cell.
+ * @return Number of steps between the cells.
+ */
+constexpr int hexDistance(int a, int b) {
+    int aColumn = a / BOARD_SIZE;
+    int bColumn = b / BOARD_SIZE;
+    int aAxial = a % BOARD_SIZE - (aColumn - (aColumn & 1)) / 2;
+    int bAxial = b % BOARD_SIZE - (bColumn - (bColumn & 1)) / 2;
+    int dq = bColumn - aColumn;
+    int dr = bAxial - aAxial;
+    int ds = dq + dr;
+    return ((dq < 0 ? -dq : dq) + (dr < 0 ? -dr : dr) + (ds < 0 ? -ds : ds)) / 2;
+}
+
+/**
+ * @brief Builds, for every cell, the mask of playable cells at exactly the given distance.
+ * Holes get an empty mask.
+ * @param distance Required hex distance.
+ */
+constexpr std::array<Bitboard, CELL_COUNT> neighbourTable(int distance) {
+    std::array<Bitboard, CELL_COUNT> table{};
+    for (int from = 0; from < CELL_COUNT; from++) {
+        if (!PLAYABLE.test(from)) {
+            continue;
+        }
+        for (int to = 0; to < CELL_COUNT; to++) {
+            if (PLAYABLE.test(to) && hexDistance(from, to) == distance) {
+                table[from].set(to);
+            }
+        }
+    }
+    return table;
+}
+
+//Cells a pawn clones into and captures around
+constexpr std::array<Bitboard, CELL_COUNT> ADJACENT_CELLS = neighbourTable(1);
+//Cells a pawn jumps to
+constexpr std::array<Bitboard, CELL_COUNT> JUMP_CELLS = neighbourTable(2);
+
+static_assert(PLAYABLE.count() == 58);
+static_assert(ADJACENT_CELLS[56].count() == 6 && JUMP_CELLS[40].count() == 12);
+
+/**
+ * @brief Builds the mask of the grid cells, holes included, that satisfy a condition.
+ * @param test Condition on the column and row of a cell.
+ */
+constexpr Bitboard gridMask(bool (*test)(int column, int row)) {
+    Bitboard mask;
+    for (int column = 0; column < BOARD_SIZE; column++) {
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            if (test(column, row)) {
+                mask.set(column * BOARD_SIZE + row);
+            }
+        }
+    }
+    return mask;
+}
+
+constexpr Bitboard GRID = gridMask([](int, int) { return true; });
+constexpr Bitboard TOP_ROW = gridMask([](int, int row) { return row == 0; });
+constexpr Bitboard BOTTOM_ROW = gridMask([](int, int row) { return row == BOARD_SIZE - 1; });
+constexpr Bitboard EVEN_COLUMNS = gridMask([](int column, int) { return column % 2 == 0; });
+
+/**
+ * @brief Collects the grid cells next to any cell of a set, with a handful of shifts instead of a table per cell.
+ * Same-column neighbours are one row up or down. Even columns also touch the row above in both side columns,
+ * odd columns the row below.
+ *
+ * @param cells Set of cells.
+ * @return Mask of the grid cells, holes included, at distance 1 of the set.
+ */
+constexpr Bitboard adjacentCells(Bitboard cells) {
+    Bitboard notTop = cells & ~TOP_ROW;
+    Bitboard notBottom = cells & ~BOTTOM_ROW;
+    Bitboard up = notTop & EVEN_COLUMNS;
+    Bitboard down = notBottom & ~EVEN_COLUMNS;
+    Bitboard result = (notTop >> 1) | (notBottom << 1) | (cells << BOARD_SIZE) | (cells >> BOARD_SIZE) |
+                      (up << (BOARD_SIZE - 1)) | (up >> (BOARD_SIZE + 1)) |
+                      (down << (BOARD_SIZE + 1)) | (down >> (BOARD_SIZE - 1));
+    return result & GRID;
+}
+
+/**
+ * @brief Collects the playable cells a pawn of a set can clone or jump to, the set itself included.
+ * Jumps may pass over holes, so the first step is not limited to playable cells.
+ *
+ * @param cells Set of playable cells.
+ * @return Mask of the playable cells at distance 2 or less of the set.
+ */
+constexpr Bitboard cellsWithinTwo(Bitboard cells) {
+    return adjacentCells(adjacentCells(cells)) & PLAYABLE;
+}
+
+/**
+ * @brief Checks the shift expansion against the per-cell tables for every playable cell.
+ */
+constexpr bool shiftsMatchTables() {
+    for (int i = 0; i < CELL_COUNT; i++) {
+        Bitboard cell = Bitboard::cell(i);
+        if (PLAYABLE.test(i) && ((adjacentCells(cell) & PLAYABLE) != ADJACENT_CELLS[i] ||
+                                 cellsWithinTwo(cell) != (ADJACENT_CELLS[i] | JUMP_CELLS[i] | cell))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(shiftsMatchTables());
+
+
+#endif //HEXXAGON_HEX_H
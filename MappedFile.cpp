@@ -0,0 +1,132 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Destroys the MappedFile object, unmapping the file.
+ */
+MappedFile::~MappedFile() {
+    this->close();
+}
+
+/**
+ * @brief Maps a file for reading. A file mapped before is unmapped first.
+ * An empty file opens successfully with no data.
+ *
+ * @param path Path of the file.
+ * @return True if the file was mapped.
+ */
+bool MappedFile::open(const std::string& path) {
+    this->close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    this->file = file;
+    this->length = static_cast<size_t>(size.QuadPart);
+    if (this->length == 0) {
+        return true;
+    }
+    this->mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->mapping == nullptr) {
+        this->close();
+        return false;
+    }
+    this->bytes = static_cast<const uint8_t*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+    if (this->bytes == nullptr) {
+        this->close();
+        return false;
+    }
+    return true;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    this->length = static_cast<size_t>(info.st_size);
+    if (this->length == 0) {
+        ::close(fd);
+        this->bytes = reinterpret_cast<const uint8_t*>("");
+        return true;
+    }
+    void* address = mmap(nullptr, this->length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        this->length = 0;
+        return false;
+    }
+    this->bytes = static_cast<const uint8_t*>(address);
+    return true;
+#endif
+}
+
+/**
+ * @brief Unmaps the file, if one is mapped.
+ */
+void MappedFile::close() {
+#ifdef _WIN32
+    if (this->bytes != nullptr) {
+        UnmapViewOfFile(this->bytes);
+    }
+    if (this->mapping != nullptr) {
+        CloseHandle(this->mapping);
+    }
+    if (this->file != nullptr) {
+        CloseHandle(this->file);
+    }
+    this->mapping = nullptr;
+    this->file = nullptr;
+#else
+    if (this->bytes != nullptr && this->length > 0) {
+        munmap(const_cast<uint8_t*>(this->bytes), this->length);
+    }
+#endif
+    this->bytes = nullptr;
+    this->length = 0;
+}
+
+/**
+ * @brief Tells whether a file is mapped.
+ */
+bool MappedFile::isOpen() const {
+#ifdef _WIN32
+    return this->file != nullptr;
+#else
+    return this->bytes != nullptr;
+#endif
+}
+
+/**
+ * @brief Retrieves the first byte of the file. Valid while the file stays mapped.
+ */
+const uint8_t* MappedFile::data() const {
+    return this->bytes;
+}
+
+/**
+ * @brief Retrieves the size of the file in bytes.
+ */
+size_t MappedFile::size() const {
+    return this->length;
+}
@@ -0,0 +1,35 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef HEXXAGON_MAPPEDFILE_H
+#define HEXXAGON_MAPPEDFILE_H
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ * The pages are shared through the page cache, so processes mapping the same file keep one copy in memory.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    virtual ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    const uint8_t* data() const;
+    size_t size() const;
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
+
+
+#endif //HEXXAGON_MAPPEDFILE_H
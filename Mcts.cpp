@@ -0,0 +1,302 @@
+#include "Mcts.h"
+#include "Evaluation.h"
+#include "Hex.h"
+#include "MoveGen.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//Node states
+constexpr uint8_t NODE_UNEXPANDED = 0;
+constexpr uint8_t NODE_EXPANDING = 1;
+constexpr uint8_t NODE_EXPANDED = 2;
+constexpr uint8_t NODE_LEAF = 3;
+
+//Reward of a won playout, a draw scores half of it
+constexpr int WIN_REWARD = 1000;
+//Win rates are fractions of WIN_REWARD, so exploration is scaled for rewards between 0 and 1
+constexpr double EXPLORATION = 0.3;
+//Greedy moves of a playout before the evaluation scores it, and the score that makes a win about 73% likely
+constexpr int PLAYOUT_PLIES = 2;
+constexpr double PLAYOUT_SCALE = 200.0;
+//One playout move in this many is random rather than greedy
+constexpr int RANDOM_ONE_IN = 8;
+
+/**
+ * @brief xorshift64* step, one generator per thread.
+ */
+static uint64_t nextRandom(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Constructs a Mcts object.
+ *
+ * @param threads Number of threads, the calling one included. At least one is used.
+ * @param weights Weights of the evaluation that scores the end of every playout.
+ * @param poolNodes Capacity of the node pool. Once it is full the tree stops growing and only playouts continue.
+ */
+Mcts::Mcts(int threads, const EvalWeights& weights, size_t poolNodes) : threads(threads < 1 ? 1 : threads), weights(weights), pool(std::make_unique<MctsNode[]>(poolNodes)), poolSize(poolNodes) {
+}
+
+/**
+ * @brief Grows the tree for a position until a limit is met.
+ * limits.nodes caps the number of playouts, limits.timeMs the time, limits.depth is ignored.
+ *
+ * @param board Position to search.
+ * @param limits Playout budget, time budget and stop flag.
+ * @return Most visited root move. score is its win rate mapped to -100..100, depth the deepest node reached.
+ */
+SearchResult Mcts::run(const Board& board, const SearchLimits& limits) {
+    auto start = std::chrono::steady_clock::now();
+    SearchResult result;
+
+    MctsNode& root = this->pool[0];
+    root.visits.store(0);
+    root.reward.store(0);
+    root.state.store(NODE_UNEXPANDED);
+    this->poolUsed.store(1);
+    this->playouts.store(0);
+    this->maxDepth.store(0);
+
+    if (!this->expand(root, board) || root.childCount.load() == 0) {
+        result.score = terminalScore(board, 0);
+        return result;
+    }
+
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < this->threads; i++) {
+        helpers.emplace_back(&Mcts::worker, this, std::cref(board), std::cref(limits), start, 0x9E3779B97F4A7C15ull * (i + 1));
+    }
+    this->worker(board, limits, start, 0x9E3779B97F4A7C15ull);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    uint32_t first = root.firstChild.load();
+    uint32_t best = first;
+    for (uint32_t i = first; i < first + root.childCount.load(); i++) {
+        if (this->pool[i].visits.load() > this->pool[best].visits.load()) {
+            best = i;
+        }
+    }
+    const MctsNode& bestNode = this->pool[best];
+    int visits = bestNode.visits.load();
+    result.bestMove = bestNode.move;
+    result.hasMove = true;
+    result.score = visits > 0 ? static_cast<int>(std::lround(200.0 * bestNode.reward.load() / (static_cast<double>(WIN_REWARD) * visits) - 100.0)) : 0;
+    result.depth = this->maxDepth.load();
+    result.nodes = this->playouts.load();
+    result.timeMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
+
+/**
+ * @brief Retrieves the number of search threads.
+ * @return Thread count, the calling thread included.
+ */
+int Mcts::threadCount() const {
+    return this->threads;
+}
+
+/**
+ * @brief Runs iterations on one thread until a limit is met.
+ *
+ * @param root Position at the root of the tree.
+ * @param limits Limits of the search.
+ * @param start Time the search started.
+ * @param seed Seed of this thread's random generator.
+ */
+void Mcts::worker(const Board& root, const SearchLimits& limits, std::chrono::steady_clock::time_point start, uint64_t seed) {
+    uint64_t rng = seed;
+    while (true) {
+        if (limits.nodes != 0 && this->playouts.load(std::memory_order_relaxed) >= limits.nodes) {
+            return;
+        }
+        if (limits.stop != nullptr && limits.stop->load(std::memory_order_relaxed)) {
+            return;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (limits.timeMs != 0 && std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits.timeMs) {
+            return;
+        }
+        this->iterate(root, rng);
+    }
+}
+
+/**
+ * @brief One iteration: select down the tree, expand the leaf, play it out and back the result up.
+ *
+ * @param board Copy of the root position, played forward along the selected path.
+ * @param rng Random generator of the calling thread.
+ */
+void Mcts::iterate(Board board, uint64_t& rng) {
+    uint32_t path[MAX_PLY + 1];
+    int length = 0;
+    uint32_t index = 0;
+    path[length++] = index;
+    this->pool[index].visits.fetch_add(1, std::memory_order_relaxed);
+
+    while (length <= MAX_PLY) {
+        MctsNode& node = this->pool[index];
+        uint8_t state = node.state.load(std::memory_order_acquire);
+        if (state == NODE_UNEXPANDED && node.visits.load(std::memory_order_relaxed) > 1) {
+            this->expand(node, board);
+            state = node.state.load(std::memory_order_acquire);
+        }
+        if (state != NODE_EXPANDED || node.childCount.load(std::memory_order_relaxed) == 0) {
+            break;
+        }
+
+        index = this->select(node);
+        MctsNode& child = this->pool[index];
+        child.visits.fetch_add(1, std::memory_order_relaxed);
+        MoveRecord record;
+        board.makeMove(child.move, record);
+        path[length++] = index;
+    }
+
+    int depth = length - 1;
+    int seen = this->maxDepth.load(std::memory_order_relaxed);
+    while (depth > seen && !this->maxDepth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+    }
+
+    //Reward for the side to move at the leaf, then alternate towards the root
+    int reward = this->playout(board, rng);
+    for (int i = length - 1; i >= 1; i--) {
+        reward = WIN_REWARD - reward;
+        this->pool[path[i]].reward.fetch_add(reward, std::memory_order_relaxed);
+    }
+    this->playouts.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the children of a node, one per legal move. Only one thread wins the right to expand a node.
+ *
+ * @param node Node to expand.
+ * @param board Position of the node.
+ * @return True if this call expanded the node.
+ */
+bool Mcts::expand(MctsNode& node, const Board& board) {
+    uint8_t expected = NODE_UNEXPANDED;
+    if (!node.state.compare_exchange_strong(expected, NODE_EXPANDING, std::memory_order_acquire)) {
+        return false;
+    }
+
+    MoveList moves;
+    generateMoves(board, moves);
+    size_t first = this->poolUsed.fetch_add(moves.size(), std::memory_order_relaxed);
+    if (first + moves.size() > this->poolSize) {
+        node.state.store(NODE_LEAF, std::memory_order_release);
+        return false;
+    }
+
+    for (int i = 0; i < moves.size(); i++) {
+        MctsNode& child = this->pool[first + i];
+        child.move = moves[i];
+        child.visits.store(0, std::memory_order_relaxed);
+        child.reward.store(0, std::memory_order_relaxed);
+        child.firstChild.store(0, std::memory_order_relaxed);
+        child.childCount.store(0, std::memory_order_relaxed);
+        child.state.store(NODE_UNEXPANDED, std::memory_order_relaxed);
+    }
+    node.firstChild.store(static_cast<uint32_t>(first), std::memory_order_relaxed);
+    node.childCount.store(static_cast<uint16_t>(moves.size()), std::memory_order_relaxed);
+    node.state.store(NODE_EXPANDED, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Picks the child with the highest UCT value. Unvisited children are tried first.
+ *
+ * @param node Expanded node.
+ * @return Pool index of the chosen child.
+ */
+uint32_t Mcts::select(const MctsNode& node) const {
+    uint32_t first = node.firstChild.load(std::memory_order_relaxed);
+    uint32_t count = node.childCount.load(std::memory_order_relaxed);
+    double logVisits = std::log(static_cast<double>(node.visits.load(std::memory_order_relaxed)) + 1.0);
+
+    uint32_t best = first;
+    double bestValue = -1.0;
+    for (uint32_t i = first; i < first + count; i++) {
+        const MctsNode& child = this->pool[i];
+        int visits = child.visits.load(std::memory_order_relaxed);
+        if (visits == 0) {
+            return i;
+        }
+        double value = child.reward.load(std::memory_order_relaxed) / (static_cast<double>(WIN_REWARD) * visits) +
+                       EXPLORATION * std::sqrt(logVisits / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Picks a playout move: usually one that flips the most pawns, clones counting one more, sometimes any move.
+ * Ties are broken at random so playouts from the same position differ.
+ *
+ * @param board Position to move in.
+ * @param moves Legal moves of the position, not empty.
+ * @param rng Random generator of the calling thread.
+ * @return The chosen move.
+ */
+static const Move& playoutMove(const Board& board, const MoveList& moves, uint64_t& rng) {
+    if (nextRandom(rng) % RANDOM_ONE_IN == 0) {
+        return moves[static_cast<int>(nextRandom(rng) % moves.size())];
+    }
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    int best = 0;
+    int bestGain = -1;
+    int ties = 0;
+    for (int i = 0; i < moves.size(); i++) {
+        int gain = (ADJACENT_CELLS[moves[i].to] & enemy).count() + (moves[i].type == MoveType::Clone ? 1 : 0);
+        if (gain > bestGain) {
+            bestGain = gain;
+            best = i;
+            ties = 1;
+        } else if (gain == bestGain && nextRandom(rng) % ++ties == 0) {
+            best = i;
+        }
+    }
+    return moves[best];
+}
+
+/**
+ * @brief Plays a few greedy moves, then maps the evaluation to a win probability.
+ * A playout that reaches the end of the game scores its result instead.
+ *
+ * @param board Position to play out. It is changed.
+ * @param rng Random generator of the calling thread.
+ * @return Reward for the side to move at the start, from 0 (loss) to WIN_REWARD (win).
+ */
+int Mcts::playout(Board& board, uint64_t& rng) const {
+    Side us = board.sideToMove;
+    MoveList moves;
+    for (int ply = 0; ply <= PLAYOUT_PLIES; ply++) {
+        if (generateMoves(board, moves) == 0) {
+            int score = terminalScore(board, 0);
+            if (score == 0) {
+                return WIN_REWARD / 2;
+            }
+            return (score > 0) == (board.sideToMove == us) ? WIN_REWARD : 0;
+        }
+        if (ply == PLAYOUT_PLIES) {
+            break;
+        }
+        MoveRecord record;
+        board.makeMove(playoutMove(board, moves, rng), record);
+    }
+    int score = evaluate(board, this->weights);
+    if (board.sideToMove != us) {
+        score = -score;
+    }
+    return static_cast<int>(std::lround(WIN_REWARD / (1.0 + std::exp(-score / PLAYOUT_SCALE))));
+}
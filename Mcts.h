@@ -0,0 +1,57 @@
+#include "Engine.h"
+#include "Evaluation.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#ifndef HEXXAGON_MCTS_H
+#define HEXXAGON_MCTS_H
+
+/**
+ * @brief Node of the Monte Carlo tree. Children of a node sit next to each other in the pool.
+ * reward sums the playout rewards (WIN_REWARD per win) for the side that played move.
+ */
+struct MctsNode {
+    Move move;
+    std::atomic<int32_t> visits{0};
+    std::atomic<int64_t> reward{0};
+    std::atomic<uint32_t> firstChild{0};
+    std::atomic<uint16_t> childCount{0};
+    std::atomic<uint8_t> state{0};
+};
+
+/**
+ * @brief Monte Carlo tree search with UCT selection and tree parallelism.
+ * Playouts are a few greedy, capture-first moves scored by the evaluation, not random games to the end.
+ * All threads grow one shared tree. A thread descending through a node counts its visit straight away
+ * (a virtual loss) so other threads prefer different branches until its playout result is added.
+ * Nodes come from a pool allocated once, so searching never allocates per node.
+ */
+class Mcts : public Engine {
+public:
+    explicit Mcts(int threads, const EvalWeights& weights = EvalWeights(), size_t poolNodes = 1 << 21);
+
+    SearchResult run(const Board& board, const SearchLimits& limits) override;
+    int threadCount() const override;
+
+private:
+    int threads;
+    EvalWeights weights;
+    std::unique_ptr<MctsNode[]> pool;
+    size_t poolSize;
+    std::atomic<size_t> poolUsed{0};
+    std::atomic<uint64_t> playouts{0};
+    std::atomic<int> maxDepth{0};
+
+    void worker(const Board& root, const SearchLimits& limits, std::chrono::steady_clock::time_point start, uint64_t seed);
+    void iterate(Board board, uint64_t& rng);
+    bool expand(MctsNode& node, const Board& board);
+    uint32_t select(const MctsNode& node) const;
+    int playout(Board& board, uint64_t& rng) const;
+};
+
+
+#endif //HEXXAGON_MCTS_H
@@ -0,0 +1,85 @@
+#include "Bitboard.h"
+
+#include <cstdint>
+
+#ifndef HEXXAGON_MOVE_H
+#define HEXXAGON_MOVE_H
+
+enum class MoveType : uint8_t {
+    Clone,
+    Jump
+};
+
+/**
+ * @brief A single move. A clone keeps the source pawn, a jump empties it.
+ */
+struct Move {
+    uint8_t from = 0;
+    uint8_t to = 0;
+    MoveType type = MoveType::Clone;
+
+    bool operator==(const Move& o) const = default;
+};
+
+/**
+ * @brief Everything needed to take a move back: the move itself and the pawns it flipped.
+ */
+struct MoveRecord {
+    Move move;
+    Bitboard flipped;
+};
+
+//Upper bound on the moves of one position: at most 46 pawns with 12 jump targets each, plus clones
+constexpr int MAX_MOVES = 640;
+
+/**
+ * @brief Fixed-capacity move list meant to live on the stack.
+ */
+class MoveList {
+public:
+    Move moves[MAX_MOVES];
+    int count = 0;
+
+    void push(const Move& move) {
+        this->moves[this->count++] = move;
+    }
+
+    int size() const {
+        return this->count;
+    }
+
+    bool empty() const {
+        return this->count == 0;
+    }
+
+    void clear() {
+        this->count = 0;
+    }
+
+    Move& operator[](int i) {
+        return this->moves[i];
+    }
+
+    const Move& operator[](int i) const {
+        return this->moves[i];
+    }
+
+    Move* begin() {
+        return this->moves;
+    }
+
+    Move* end() {
+        return this->moves + this->count;
+    }
+
+    const Move* begin() const {
+        return this->moves;
+    }
+
+    const Move* end() const {
+        return this->moves + this->count;
+    }
+};
+
+
+#endif //HEXXAGON_MOVE_H
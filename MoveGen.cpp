@@ -0,0 +1,74 @@
+#include "MoveGen.h"
+#include "Hex.h"
+
+/**
+ * @brief Generates every legal move of the side to move.
+ * Clones that land on the same cell give the same position, so only one clone per target cell is listed.
+ *
+ * @param board Position to generate moves for.
+ * @param list List the moves are appended to. It is cleared first.
+ * @return Number of moves generated.
+ */
+int generateMoves(const Board& board, MoveList& list) {
+    list.clear();
+    Bitboard own = board.pieces(board.sideToMove);
+    Bitboard empty = board.empty();
+
+    Bitboard cloneTargets;
+    for (Bitboard pawns = own; pawns.any();) {
+        int from = pawns.popLsb();
+        Bitboard targets = ADJACENT_CELLS[from] & empty & ~cloneTargets;
+        cloneTargets |= targets;
+        while (targets.any()) {
+            list.push({static_cast<uint8_t>(from), static_cast<uint8_t>(targets.popLsb()), MoveType::Clone});
+        }
+    }
+
+    for (Bitboard pawns = own; pawns.any();) {
+        int from = pawns.popLsb();
+        for (Bitboard targets = JUMP_CELLS[from] & empty; targets.any();) {
+            list.push({static_cast<uint8_t>(from), static_cast<uint8_t>(targets.popLsb()), MoveType::Jump});
+        }
+    }
+    return list.size();
+}
+
+/**
+ * @brief Checks whether a side can make any move.
+ *
+ * @param board Position to check.
+ * @param side Side to check for.
+ * @return True if at least one empty cell is within reach of a pawn of that side.
+ */
+bool hasMoves(const Board& board, Side side) {
+    return (cellsWithinTwo(board.pieces(side)) & board.empty()).any();
+}
+
+/**
+ * @brief Checks whether the side to move may play a move.
+ *
+ * @param board Position to check.
+ * @param move Move to check.
+ * @return True if the source holds a pawn of the side to move and the target is an empty cell at the move's distance.
+ */
+bool isLegalMove(const Board& board, const Move& move) {
+    if (!board.pieces(board.sideToMove).test(move.from) || !board.empty().test(move.to)) {
+        return false;
+    }
+    if (move.type == MoveType::Clone) {
+        return ADJACENT_CELLS[move.from].test(move.to);
+    }
+    return JUMP_CELLS[move.from].test(move.to);
+}
+
+/**
+ * @brief Builds the move from one cell to another, picking clone or jump from their distance.
+ *
+ * @param from Index of the source cell.
+ * @param to Index of the target cell.
+ * @return The move. Its type is Jump for any distance other than 1, so check it with isLegalMove.
+ */
+Move moveBetween(int from, int to) {
+    MoveType type = ADJACENT_CELLS[from].test(to) ? MoveType::Clone : MoveType::Jump;
+    return {static_cast<uint8_t>(from), static_cast<uint8_t>(to), type};
+}
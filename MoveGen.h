@@ -0,0 +1,13 @@
+#include "Board.h"
+#include "Move.h"
+
+#ifndef HEXXAGON_MOVEGEN_H
+#define HEXXAGON_MOVEGEN_H
+
+int generateMoves(const Board& board, MoveList& list);
+bool hasMoves(const Board& board, Side side);
+bool isLegalMove(const Board& board, const Move& move);
+Move moveBetween(int from, int to);
+
+
+#endif //HEXXAGON_MOVEGEN_H
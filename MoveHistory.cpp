@@ -0,0 +1,87 @@
+#include "MoveHistory.h"
+
+/**
+ * @brief Constructs an empty MoveHistory with room for a whole game, so playing moves does not allocate.
+ */
+MoveHistory::MoveHistory() {
+    this->records.reserve(HISTORY_CAPACITY);
+}
+
+/**
+ * @brief Plays a move and records it. Moves that could still be redone are dropped.
+ *
+ * @param board Board at the current position of the history.
+ * @param move Legal move of the side to move.
+ * @return Number of enemy pawns flipped.
+ */
+int MoveHistory::play(Board& board, const Move& move) {
+    this->records.resize(this->current);
+    MoveRecord record;
+    int flips = board.makeMove(move, record);
+    this->records.push_back(record);
+    this->current++;
+    return flips;
+}
+
+/**
+ * @brief Takes back the last played move.
+ *
+ * @param board Board at the current position of the history.
+ * @return True if there was a move to take back.
+ */
+bool MoveHistory::undo(Board& board) {
+    if (!this->canUndo()) {
+        return false;
+    }
+    board.unmakeMove(this->records[--this->current]);
+    return true;
+}
+
+/**
+ * @brief Plays again the move taken back last.
+ *
+ * @param board Board at the current position of the history.
+ * @return True if there was a move to play again.
+ */
+bool MoveHistory::redo(Board& board) {
+    if (!this->canRedo()) {
+        return false;
+    }
+    MoveRecord& record = this->records[this->current++];
+    board.makeMove(record.move, record);
+    return true;
+}
+
+/**
+ * @brief Forgets every move, for a new game.
+ */
+void MoveHistory::clear() {
+    this->records.clear();
+    this->current = 0;
+}
+
+bool MoveHistory::canUndo() const {
+    return this->current > 0;
+}
+
+bool MoveHistory::canRedo() const {
+    return this->current < static_cast<int>(this->records.size());
+}
+
+/**
+ * @brief Retrieves the number of moves played up to the current position.
+ */
+int MoveHistory::position() const {
+    return this->current;
+}
+
+/**
+ * @brief Retrieves the number of recorded moves, including those that can be redone.
+ */
+int MoveHistory::size() const {
+    return static_cast<int>(this->records.size());
+}
+
+const MoveRecord& MoveHistory::operator[](int i) const {
+    return this->records[i];
+}
@@ -0,0 +1,37 @@
+#include "Board.h"
+#include "Move.h"
+
+#include <vector>
+
+#ifndef HEXXAGON_MOVEHISTORY_H
+#define HEXXAGON_MOVEHISTORY_H
+
+//Room reserved up front, enough for any ordinary game
+constexpr int HISTORY_CAPACITY = 512;
+
+/**
+ * @brief Moves played in a game, kept as the MoveRecords make/unmake use in the search.
+ * Undo and redo are a single unmakeMove or makeMove, so stepping through a game never rescans the board.
+ * Moves after the current position stay available for redo until a different move is played.
+ */
+class MoveHistory {
+public:
+    MoveHistory();
+
+    int play(Board& board, const Move& move);
+    bool undo(Board& board);
+    bool redo(Board& board);
+    void clear();
+    bool canUndo() const;
+    bool canRedo() const;
+    int position() const;
+    int size() const;
+    const MoveRecord& operator[](int i) const;
+
+private:
+    std::vector<MoveRecord> records;
+    int current = 0;
+};
+
+
+#endif //HEXXAGON_MOVEHISTORY_H
@@ -0,0 +1,243 @@
+#include "Nnue.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+//Magic, version, input count, hidden count, output divisor and output bias
+constexpr size_t NETWORK_HEADER_SIZE = 24;
+
+/**
+ * @brief Reads a little-endian value of N bytes.
+ */
+template <typename T, int N = sizeof(T)>
+static T readLittleEndian(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int b = 0; b < N; b++) {
+        value |= static_cast<uint64_t>(data[b]) << (8 * b);
+    }
+    return static_cast<T>(value);
+}
+
+/**
+ * @brief Appends a value as N little-endian bytes.
+ */
+template <typename T, int N = sizeof(T)>
+static void writeLittleEndian(std::vector<char>& out, T value) {
+    auto bits = static_cast<uint64_t>(value);
+    for (int b = 0; b < N; b++) {
+        out.push_back(static_cast<char>(bits >> (8 * b)));
+    }
+}
+
+/**
+ * @brief Constructs an NnueNetwork object with every weight zero, which scores every position 0.
+ */
+NnueNetwork::NnueNetwork()
+        : featureWeights(NNUE_INPUTS * NNUE_HIDDEN), featureBias(NNUE_HIDDEN), outputWeights(2 * NNUE_HIDDEN) {
+}
+
+/**
+ * @brief Loads the weights from a file written by save.
+ * The file must have this build's format version and layer sizes, otherwise the network is left as it was.
+ *
+ * @param path Path of the network file.
+ * @return False if the file is missing or does not match.
+ */
+bool NnueNetwork::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t expected = NETWORK_HEADER_SIZE + 2 * this->featureWeights.size() + 2 * this->featureBias.size() +
+                      this->outputWeights.size();
+    if (data.size() != expected || !std::equal(NETWORK_FILE_MAGIC, NETWORK_FILE_MAGIC + 4, data.begin()) ||
+        readLittleEndian<uint32_t>(&data[4]) != NETWORK_FORMAT_VERSION ||
+        readLittleEndian<uint32_t>(&data[8]) != NNUE_INPUTS || readLittleEndian<uint32_t>(&data[12]) != NNUE_HIDDEN ||
+        readLittleEndian<int32_t>(&data[16]) <= 0) {
+        return false;
+    }
+
+    this->outputDivisor = readLittleEndian<int32_t>(&data[16]);
+    this->outputBias = readLittleEndian<int32_t>(&data[20]);
+    size_t pos = NETWORK_HEADER_SIZE;
+    for (int16_t& weight : this->featureWeights) {
+        weight = readLittleEndian<int16_t>(&data[pos]);
+        pos += 2;
+    }
+    for (int16_t& bias : this->featureBias) {
+        bias = readLittleEndian<int16_t>(&data[pos]);
+        pos += 2;
+    }
+    for (int8_t& weight : this->outputWeights) {
+        weight = static_cast<int8_t>(data[pos++]);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the weights to a file that load reads back.
+ *
+ * @param path Path of the network file.
+ * @return False if the file could not be written.
+ */
+bool NnueNetwork::save(const std::string& path) const {
+    std::vector<char> bytes(NETWORK_FILE_MAGIC, NETWORK_FILE_MAGIC + 4);
+    writeLittleEndian<uint32_t>(bytes, NETWORK_FORMAT_VERSION);
+    writeLittleEndian<uint32_t>(bytes, NNUE_INPUTS);
+    writeLittleEndian<uint32_t>(bytes, NNUE_HIDDEN);
+    writeLittleEndian<int32_t>(bytes, this->outputDivisor);
+    writeLittleEndian<int32_t>(bytes, this->outputBias);
+    for (int16_t weight : this->featureWeights) {
+        writeLittleEndian<int16_t>(bytes, weight);
+    }
+    for (int16_t bias : this->featureBias) {
+        writeLittleEndian<int16_t>(bytes, bias);
+    }
+    for (int8_t weight : this->outputWeights) {
+        writeLittleEndian<int8_t>(bytes, weight);
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return out.good();
+}
+
+/**
+ * @brief Numbers the input of a pawn as one side sees it.
+ *
+ * @param perspective Side looking at the board.
+ * @param owner Owner of the pawn.
+ * @param cell Cell of the pawn.
+ * @return Index of the input, own pawns in the first half and enemy pawns in the second.
+ */
+int NnueNetwork::featureIndex(Side perspective, Side owner, int cell) {
+    return (owner == perspective ? 0 : CELL_COUNT) + cell;
+}
+
+void NnueNetwork::addFeature(int16_t* values, int feature) const {
+    const int16_t* column = &this->featureWeights[feature * NNUE_HIDDEN];
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] = static_cast<int16_t>(values[i] + column[i]);
+    }
+}
+
+void NnueNetwork::subtractFeature(int16_t* values, int feature) const {
+    const int16_t* column = &this->featureWeights[feature * NNUE_HIDDEN];
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        values[i] = static_cast<int16_t>(values[i] - column[i]);
+    }
+}
+
+/**
+ * @brief Computes the accumulator of a position from scratch.
+ *
+ * @param board Position to compute it for.
+ * @param accumulator Filled with both sides' first-layer outputs.
+ */
+void NnueNetwork::refresh(const Board& board, NnueAccumulator& accumulator) const {
+    for (Side perspective : {Side::White, Side::Black}) {
+        int16_t* values = accumulator.values[static_cast<int>(perspective)];
+        std::copy(this->featureBias.begin(), this->featureBias.end(), values);
+        for (Side owner : {Side::White, Side::Black}) {
+            for (Bitboard pawns = board.pieces(owner); pawns.any();) {
+                this->addFeature(values, featureIndex(perspective, owner, pawns.popLsb()));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Derives the accumulator after a move from the one before it.
+ * Only the target, the source of a jump and the flipped pawns change, at most 14 weight columns per side.
+ * Taking the move back needs no work: the caller keeps the accumulator from before the move.
+ *
+ * @param before Accumulator of the position the move was played in.
+ * @param after Filled with the accumulator of the position after the move.
+ * @param mover Side that played the move.
+ * @param record Record makeMove filled for the move.
+ */
+void NnueNetwork::update(const NnueAccumulator& before, NnueAccumulator& after, Side mover,
+                         const MoveRecord& record) const {
+    Side enemy = opponent(mover);
+    for (Side perspective : {Side::White, Side::Black}) {
+        int p = static_cast<int>(perspective);
+        std::copy(before.values[p], before.values[p] + NNUE_HIDDEN, after.values[p]);
+        this->addFeature(after.values[p], featureIndex(perspective, mover, record.move.to));
+        if (record.move.type == MoveType::Jump) {
+            this->subtractFeature(after.values[p], featureIndex(perspective, mover, record.move.from));
+        }
+        for (Bitboard flipped = record.flipped; flipped.any();) {
+            int cell = flipped.popLsb();
+            this->subtractFeature(after.values[p], featureIndex(perspective, enemy, cell));
+            this->addFeature(after.values[p], featureIndex(perspective, mover, cell));
+        }
+    }
+}
+
+/**
+ * @brief Output layer one value at a time.
+ */
+static int32_t outputSumScalar(const int16_t* own, const int16_t* enemy, const int8_t* weights) {
+    int32_t sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; i++) {
+        sum += std::clamp<int32_t>(own[i], 0, NNUE_ACTIVATION_MAX) * weights[i];
+        sum += std::clamp<int32_t>(enemy[i], 0, NNUE_ACTIVATION_MAX) * weights[NNUE_HIDDEN + i];
+    }
+    return sum;
+}
+
+#ifdef HEXX_AVX2_KERNEL
+
+/**
+ * @brief Output layer 32 values at a time.
+ * Saturating packs to int8 clip at 127 and a maximum with zero clips at 0. The packs interleave the two 128-bit
+ * halves, so a permute restores the order before the unsigned by signed multiply-add against the weights.
+ */
+HEXX_AVX2_TARGET static int32_t outputSumAvx2(const int16_t* own, const int16_t* enemy, const int8_t* weights) {
+    static_assert(NNUE_HIDDEN % 32 == 0 && NNUE_ACTIVATION_MAX == 127);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = zero;
+    const int16_t* halves[2] = {own, enemy};
+    for (int half = 0; half < 2; half++) {
+        for (int i = 0; i < NNUE_HIDDEN; i += 32) {
+            __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(halves[half] + i));
+            __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(halves[half] + i + 16));
+            __m256i clipped = _mm256_max_epi8(_mm256_packs_epi16(a, b), zero);
+            clipped = _mm256_permute4x64_epi64(clipped, 0xD8);
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + half * NNUE_HIDDEN + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(clipped, w), ones));
+        }
+    }
+    __m128i folded = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    folded = _mm_add_epi32(folded, _mm_shuffle_epi32(folded, 0x4E));
+    folded = _mm_add_epi32(folded, _mm_shuffle_epi32(folded, 0xB1));
+    return _mm_cvtsi128_si32(folded);
+}
+
+#endif
+
+/**
+ * @brief Scores a position from its accumulator.
+ *
+ * @param accumulator Accumulator of the position.
+ * @param sideToMove Side the score is for.
+ * @return Score in hundredths of a pawn, positive when the side to move is better.
+ */
+int NnueNetwork::evaluate(const NnueAccumulator& accumulator, Side sideToMove) const {
+    const int16_t* own = accumulator.values[static_cast<int>(sideToMove)];
+    const int16_t* enemy = accumulator.values[static_cast<int>(opponent(sideToMove))];
+    int32_t sum;
+#ifdef HEXX_AVX2_KERNEL
+    if (useAvx2()) {
+        sum = outputSumAvx2(own, enemy, this->outputWeights.data());
+    } else {
+        sum = outputSumScalar(own, enemy, this->outputWeights.data());
+    }
+#else
+    sum = outputSumScalar(own, enemy, this->outputWeights.data());
+#endif
+    return (sum + this->outputBias) / this->outputDivisor;
+}
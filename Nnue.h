@@ -0,0 +1,61 @@
+#include "Board.h"
+#include "Move.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef HEXXAGON_NNUE_H
+#define HEXXAGON_NNUE_H
+
+constexpr char NETWORK_FILE_MAGIC[4] = {'H', 'X', 'N', 'N'};
+constexpr uint32_t NETWORK_FORMAT_VERSION = 1;
+//One input per cell and owner, seen from one side: its own pawns first, then the enemy's
+constexpr int NNUE_INPUTS = 2 * CELL_COUNT;
+constexpr int NNUE_HIDDEN = 64;
+//Accumulator values are clipped to 0..NNUE_ACTIVATION_MAX before the output layer, which stands for 0..1
+constexpr int NNUE_ACTIVATION_MAX = 127;
+
+/**
+ * @brief First-layer outputs of a position, once from each side's point of view.
+ * Indexed by Side, so values[static_cast<int>(side)] sees the board as that side.
+ */
+struct NnueAccumulator {
+    alignas(32) int16_t values[2][NNUE_HIDDEN];
+};
+
+/**
+ * @brief Small quantised network scoring a position from its occupancy.
+ * The first layer is a sum of int16 weight columns, one per occupied cell, kept in an accumulator that moves update
+ * instead of recomputing it. The output layer weighs the clipped accumulators of the side to move and of the other
+ * side with int8 weights.
+ */
+class NnueNetwork {
+public:
+    NnueNetwork();
+
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void refresh(const Board& board, NnueAccumulator& accumulator) const;
+    void update(const NnueAccumulator& before, NnueAccumulator& after, Side mover, const MoveRecord& record) const;
+    int evaluate(const NnueAccumulator& accumulator, Side sideToMove) const;
+
+    static int featureIndex(Side perspective, Side owner, int cell);
+
+    //[feature][hidden], then the bias of each hidden value
+    std::vector<int16_t> featureWeights;
+    std::vector<int16_t> featureBias;
+    //Side to move's half first, then the other side's
+    std::vector<int8_t> outputWeights;
+    int32_t outputBias = 0;
+    //The output sum is divided by this to give hundredths of a pawn
+    int32_t outputDivisor = 1;
+
+private:
+    void addFeature(int16_t* values, int feature) const;
+    void subtractFeature(int16_t* values, int feature) const;
+};
+
+
+#endif //HEXXAGON_NNUE_H
@@ -0,0 +1,146 @@
+#include "OpeningBook.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <fstream>
+
+/**
+ * @brief Maps a book file written by write.
+ *
+ * @param path Path of the book.
+ * @return False if the file is missing or not a book.
+ */
+bool OpeningBook::open(const std::string& path) {
+    this->count = 0;
+    if (!this->file.open(path)) {
+        return false;
+    }
+    const uint8_t* data = this->file.data();
+    if (this->file.size() < 8 || !std::equal(BOOK_FILE_MAGIC, BOOK_FILE_MAGIC + 4, data) ||
+        data[4] != BOOK_FORMAT_VERSION) {
+        this->file.close();
+        return false;
+    }
+    this->count = (this->file.size() - 8) / BOOK_ENTRY_SIZE;
+    return true;
+}
+
+bool OpeningBook::isOpen() const {
+    return this->file.isOpen();
+}
+
+/**
+ * @brief Retrieves the number of entries in the book.
+ */
+size_t OpeningBook::size() const {
+    return this->count;
+}
+
+/**
+ * @brief Reads one entry from the mapping.
+ * @param i Index of the entry.
+ */
+BookEntry OpeningBook::entry(size_t i) const {
+    const uint8_t* data = this->file.data() + 8 + i * BOOK_ENTRY_SIZE;
+    BookEntry entry;
+    for (int b = 0; b < 8; b++) {
+        entry.key |= static_cast<uint64_t>(data[b]) << (8 * b);
+    }
+    entry.move = {data[8], static_cast<uint8_t>(data[9] & 0x7F), (data[9] & 0x80) ? MoveType::Jump : MoveType::Clone};
+    for (int b = 0; b < 4; b++) {
+        entry.games |= static_cast<uint32_t>(data[10 + b]) << (8 * b);
+        entry.points |= static_cast<uint32_t>(data[14 + b]) << (8 * b);
+    }
+    return entry;
+}
+
+/**
+ * @brief Collects the book moves of a position.
+ *
+ * @param key Zobrist hash of the position.
+ * @return Entries with that key, empty if the position is not in the book.
+ */
+std::vector<BookEntry> OpeningBook::entries(uint64_t key) const {
+    size_t low = 0;
+    size_t high = this->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (this->entry(middle).key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    std::vector<BookEntry> found;
+    for (size_t i = low; i < this->count; i++) {
+        BookEntry candidate = this->entry(i);
+        if (candidate.key != key) {
+            break;
+        }
+        found.push_back(candidate);
+    }
+    return found;
+}
+
+/**
+ * @brief Picks a book move for a position, at random with weights equal to the points each move scored.
+ * Moves that always lost are never picked. Entries that are not legal, after a hash collision, are skipped.
+ *
+ * @param board Position to find a move for.
+ * @param random Random number choosing between the moves.
+ * @param move Set to the chosen move.
+ * @return False if the book has nothing for the position.
+ */
+bool OpeningBook::probe(const Board& board, uint64_t random, Move& move) const {
+    std::vector<BookEntry> candidates = this->entries(board.hash);
+    uint64_t total = 0;
+    for (BookEntry& candidate : candidates) {
+        if (!isLegalMove(board, candidate.move)) {
+            candidate.points = 0;
+        }
+        total += candidate.points;
+    }
+    if (total == 0) {
+        return false;
+    }
+    uint64_t pick = random % total;
+    for (const BookEntry& candidate : candidates) {
+        if (pick < candidate.points) {
+            move = candidate.move;
+            return true;
+        }
+        pick -= candidate.points;
+    }
+    return false;
+}
+
+/**
+ * @brief Writes a book file.
+ *
+ * @param path Path of the book.
+ * @param entries Entries to write, in any order. They are sorted by key.
+ * @return False if the file could not be written.
+ */
+bool OpeningBook::write(const std::string& path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        return a.key < b.key;
+    });
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    char header[8] = {BOOK_FILE_MAGIC[0], BOOK_FILE_MAGIC[1], BOOK_FILE_MAGIC[2], BOOK_FILE_MAGIC[3],
+                      static_cast<char>(BOOK_FORMAT_VERSION), 0, 0, 0};
+    out.write(header, sizeof(header));
+    for (const BookEntry& entry : entries) {
+        char bytes[BOOK_ENTRY_SIZE] = {};
+        for (int b = 0; b < 8; b++) {
+            bytes[b] = static_cast<char>(entry.key >> (8 * b));
+        }
+        bytes[8] = static_cast<char>(entry.move.from);
+        bytes[9] = static_cast<char>(entry.move.to | (entry.move.type == MoveType::Jump ? 0x80 : 0));
+        for (int b = 0; b < 4; b++) {
+            bytes[10 + b] = static_cast<char>(entry.games >> (8 * b));
+            bytes[14 + b] = static_cast<char>(entry.points >> (8 * b));
+        }
+        out.write(bytes, sizeof(bytes));
+    }
+    return out.good();
+}
@@ -0,0 +1,49 @@
+#include "Board.h"
+#include "MappedFile.h"
+#include "Move.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef HEXXAGON_OPENINGBOOK_H
+#define HEXXAGON_OPENINGBOOK_H
+
+constexpr char BOOK_FILE_MAGIC[4] = {'H', 'X', 'O', 'B'};
+constexpr uint32_t BOOK_FORMAT_VERSION = 1;
+//Key (8), source (1), target with the jump bit (1), games (4), half-points (4), padding (2)
+constexpr size_t BOOK_ENTRY_SIZE = 20;
+
+/**
+ * @brief Statistics of one move played from one position.
+ */
+struct BookEntry {
+    uint64_t key = 0;
+    Move move;
+    uint32_t games = 0;
+    uint32_t points = 0;
+};
+
+/**
+ * @brief Memory-mapped opening book: book entries sorted by position hash, looked up by binary search.
+ * Entries are read straight from the mapping, so processes sharing a book share its pages.
+ */
+class OpeningBook {
+public:
+    bool open(const std::string& path);
+    bool isOpen() const;
+    size_t size() const;
+    bool probe(const Board& board, uint64_t random, Move& move) const;
+    std::vector<BookEntry> entries(uint64_t key) const;
+    static bool write(const std::string& path, std::vector<BookEntry> entries);
+
+private:
+    MappedFile file;
+    size_t count = 0;
+
+    BookEntry entry(size_t i) const;
+};
+
+
+#endif //HEXXAGON_OPENINGBOOK_H
@@ -0,0 +1,122 @@
+#include "ParallelSearch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+//Node budget of the endgame solver when the search has neither a node nor a time budget
+constexpr uint64_t SOLVER_NODES = 250000;
+
+/**
+ * @brief Constructs a ParallelSearch object.
+ *
+ * @param tt Transposition table shared by every thread.
+ * @param threads Number of threads, the calling one included. At least one is used.
+ * @param weights Evaluation weights used at the leaves.
+ * @param network Network used at the leaves instead of the weights, or nullptr. Shared by every thread.
+ */
+ParallelSearch::ParallelSearch(TranspositionTable& tt, int threads, const EvalWeights& weights,
+                               const NnueNetwork* network) : tt(tt) {
+    for (int i = 0; i < std::max(threads, 1); i++) {
+        this->searches.push_back(std::make_unique<Search>(tt, weights, i, network));
+    }
+}
+
+/**
+ * @brief Searches a position on every thread until the main search meets its limits.
+ *
+ * @param board Position to search.
+ * @param searchLimits Limits of the main search. Helpers run until the main search is done.
+ * @return Result of the main search, with the nodes and table statistics of all threads added up.
+ */
+SearchResult ParallelSearch::run(const Board& board, const SearchLimits& searchLimits) {
+    SearchLimits limits = searchLimits;
+    SearchResult solvedResult;
+    if (this->trySolve(board, limits, solvedResult)) {
+        return solvedResult;
+    }
+
+    this->tt.newSearch();
+    this->helperStop.store(false);
+
+    SearchLimits helperLimits;
+    helperLimits.depth = limits.depth;
+    helperLimits.stop = &this->helperStop;
+
+    std::vector<SearchResult> helperResults(this->searches.size());
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < this->searches.size(); i++) {
+        helpers.emplace_back([this, i, &board, &helperLimits, &helperResults]() {
+            helperResults[i] = this->searches[i]->run(board, helperLimits);
+        });
+    }
+
+    SearchResult result = this->searches[0]->run(board, limits);
+
+    this->helperStop.store(true);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    for (size_t i = 1; i < helperResults.size(); i++) {
+        result.nodes += helperResults[i].nodes;
+        result.ttProbes += helperResults[i].ttProbes;
+        result.ttHits += helperResults[i].ttHits;
+        result.innerNodes += helperResults[i].innerNodes;
+        result.cutoffs += helperResults[i].cutoffs;
+    }
+    return result;
+}
+
+/**
+ * @brief Looks for a forced win with the endgame solver if few enough cells are empty, on half of the budget.
+ *
+ * @param board Position to solve.
+ * @param limits Limits of the search. The time and nodes the solver used are taken off when it fails.
+ * @param result Filled with the solution.
+ * @return True if a forced win was found.
+ */
+bool ParallelSearch::trySolve(const Board& board, SearchLimits& limits, SearchResult& result) {
+    if (limits.solveEmpty <= 0 || board.empty().count() >= limits.solveEmpty) {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    SearchLimits solverLimits = limits;
+    //At least one node, as a budget of 0 would mean no budget
+    solverLimits.nodes = limits.nodes > 0 ? std::max<uint64_t>(1, limits.nodes / 2) : 0;
+    solverLimits.timeMs = limits.timeMs > 0 ? std::max(1, limits.timeMs / 2) : 0;
+    if (solverLimits.nodes == 0 && solverLimits.timeMs == 0) {
+        solverLimits.nodes = SOLVER_NODES;
+    }
+
+    SolverResult solution = this->solver.solve(board, solverLimits);
+    int elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    if (!solution.solved) {
+        if (limits.timeMs > 0) {
+            limits.timeMs = std::max(1, limits.timeMs - elapsedMs);
+        }
+        if (limits.nodes > 0) {
+            limits.nodes = std::max<uint64_t>(1, limits.nodes - solution.nodes);
+        }
+        return false;
+    }
+
+    result.solved = true;
+    result.margin = solution.margin;
+    result.depth = solution.plies;
+    result.bestMove = solution.bestMove;
+    result.pv = {solution.bestMove};
+    result.hasMove = true;
+    result.score = WIN_SCORE - solution.plies;
+    result.nodes = solution.nodes;
+    result.timeMs = elapsedMs;
+    return true;
+}
+
+/**
+ * @brief Retrieves the number of search threads.
+ * @return Thread count, the calling thread included.
+ */
+int ParallelSearch::threadCount() const {
+    return static_cast<int>(this->searches.size());
+}
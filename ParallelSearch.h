@@ -0,0 +1,35 @@
+#include "EndgameSolver.h"
+#include "Engine.h"
+#include "Search.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#ifndef HEXXAGON_PARALLELSEARCH_H
+#define HEXXAGON_PARALLELSEARCH_H
+
+/**
+ * @brief Lazy SMP: several searches of the same position on separate threads sharing one transposition table.
+ * Helpers only fill the table, the result is that of the main search running on the calling thread.
+ * Near the end of the game the endgame solver gets the first half of the budget.
+ */
+class ParallelSearch : public Engine {
+public:
+    ParallelSearch(TranspositionTable& tt, int threads, const EvalWeights& weights = EvalWeights(),
+                   const NnueNetwork* network = nullptr);
+
+    SearchResult run(const Board& board, const SearchLimits& limits) override;
+    int threadCount() const override;
+
+private:
+    TranspositionTable& tt;
+    std::vector<std::unique_ptr<Search>> searches;
+    std::atomic<bool> helperStop{false};
+    EndgameSolver solver;
+
+    bool trySolve(const Board& board, SearchLimits& limits, SearchResult& result);
+};
+
+
+#endif //HEXXAGON_PARALLELSEARCH_H
@@ -0,0 +1,371 @@
+#include "Search.h"
+#include "Hex.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Scores a finished game from the point of view of the side to move.
+ * The side to move has no move left, so the opponent claims every remaining empty cell.
+ *
+ * @param board Final position.
+ * @param ply Distance from the root, so that quicker wins score higher.
+ * @return Win, loss or draw score.
+ */
+int terminalScore(const Board& board, int ply) {
+    Side us = board.sideToMove;
+    int margin = board.finalCount(us) - board.finalCount(opponent(us));
+    if (margin > 0) {
+        return WIN_SCORE - ply;
+    }
+    if (margin < 0) {
+        return -WIN_SCORE + ply;
+    }
+    return 0;
+}
+
+/**
+ * @brief Converts a win or loss score from distance-to-root to distance-to-node before storing it.
+ *
+ * @param score Score as returned by the search.
+ * @param ply Distance of the node from the root.
+ * @return Score to put in the transposition table.
+ */
+int scoreToTT(int score, int ply) {
+    if (score >= WIN_SCORE - MAX_PLY) {
+        return score + ply;
+    }
+    if (score <= -WIN_SCORE + MAX_PLY) {
+        return score - ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Converts a stored win or loss score back to distance-to-root.
+ *
+ * @param score Score read from the transposition table.
+ * @param ply Distance of the node from the root.
+ * @return Score as the search uses it.
+ */
+int scoreFromTT(int score, int ply) {
+    if (score >= WIN_SCORE - MAX_PLY) {
+        return score - ply;
+    }
+    if (score <= -WIN_SCORE + MAX_PLY) {
+        return score + ply;
+    }
+    return score;
+}
+
+/**
+ * @brief Constructs a Search object.
+ * @param tt Transposition table to read and fill.
+ * @param weights Evaluation weights used at the leaves.
+ * @param threadIndex Index of the thread in a parallel search. Odd helpers search one ply deeper to spread the work.
+ * @param network Network scoring the leaves instead of the weights, or nullptr. It must outlive the search.
+ */
+Search::Search(TranspositionTable& tt, const EvalWeights& weights, int threadIndex, const NnueNetwork* network)
+        : tt(tt), weights(weights), network(network), threadIndex(threadIndex) {
+    if (this->network != nullptr) {
+        this->accumulators.resize(MAX_PLY + 1);
+    }
+}
+
+/**
+ * @brief Searches a position with iterative deepening.
+ * A depth cut short by a budget or the stop flag is thrown away and the last completed depth is returned.
+ * With a time budget, no new depth is started once half of the budget is spent.
+ * The caller marks new root searches with TranspositionTable::newSearch.
+ *
+ * @param board Position to search.
+ * @param limits Maximum depth, budgets and stop flag.
+ * @return Best move found, its score and search statistics.
+ */
+SearchResult Search::run(const Board& board, const SearchLimits& limits) {
+    SearchResult result;
+    Board root = board;
+    this->nodes = 0;
+    this->ttProbes = 0;
+    this->ttHits = 0;
+    this->innerNodes = 0;
+    this->cutoffs = 0;
+    this->limits = limits;
+    this->startTime = std::chrono::steady_clock::now();
+    this->aborted = false;
+
+    MoveList moves;
+    if (generateMoves(root, moves) == 0) {
+        result.score = terminalScore(root, 0);
+        return result;
+    }
+    result.bestMove = moves[0];
+    result.hasMove = true;
+    if (this->network != nullptr) {
+        this->network->refresh(root, this->accumulators[0]);
+    }
+
+    for (int depth = 1 + (this->threadIndex & 1); depth <= limits.depth; depth++) {
+        Move bestMove;
+        int score = this->searchRoot(root, depth, bestMove);
+        if (this->aborted) {
+            break;
+        }
+        result.bestMove = bestMove;
+        result.score = score;
+        result.depth = depth;
+        result.depthTimesMs.push_back(this->elapsedMs());
+        if (score >= WIN_SCORE - MAX_PLY || score <= -WIN_SCORE + MAX_PLY) {
+            break;
+        }
+        if (limits.timeMs != 0 && this->elapsedMs() * 2 > limits.timeMs) {
+            break;
+        }
+    }
+    result.nodes = this->nodes;
+    result.timeMs = this->elapsedMs();
+    result.ttProbes = this->ttProbes;
+    result.ttHits = this->ttHits;
+    result.innerNodes = this->innerNodes;
+    result.cutoffs = this->cutoffs;
+    result.pv = this->principalVariation(root, result.bestMove, std::max(result.depth, 1));
+    return result;
+}
+
+/**
+ * @brief Reads the expected line back from the transposition table, following the stored best moves.
+ * The line ends early at a position without a legal stored move or at one already on the line.
+ *
+ * @param board Root position.
+ * @param bestMove Best root move.
+ * @param length Maximum number of moves, usually the completed depth.
+ * @return The line, starting with bestMove.
+ */
+std::vector<Move> Search::principalVariation(const Board& board, const Move& bestMove, int length) const {
+    std::vector<Move> pv{bestMove};
+    std::vector<uint64_t> seen{board.hash};
+    Board position = board;
+    MoveRecord record;
+    position.makeMove(bestMove, record);
+    TTEntry entry;
+    while (static_cast<int>(pv.size()) < length && std::find(seen.begin(), seen.end(), position.hash) == seen.end() &&
+           this->tt.probe(position.hash, entry) && entry.hasMove && isLegalMove(position, entry.move)) {
+        seen.push_back(position.hash);
+        pv.push_back(entry.move);
+        position.makeMove(entry.move, record);
+    }
+    return pv;
+}
+
+/**
+ * @brief Searches every root move to the given depth.
+ *
+ * @param board Root position.
+ * @param depth Depth to search.
+ * @param bestMove Set to the best root move.
+ * @return Score of the best root move.
+ */
+int Search::searchRoot(Board& board, int depth, Move& bestMove) {
+    MoveList moves;
+    generateMoves(board, moves);
+    TTEntry entry;
+    bool hasTTMove = this->tt.probe(board.hash, entry) && entry.hasMove;
+    int scores[MAX_MOVES];
+    this->scoreMoves(board, moves, scores, hasTTMove ? &entry.move : nullptr);
+
+    int alpha = -INFINITE_SCORE;
+    for (int i = 0; i < moves.size(); i++) {
+        pickMove(moves, scores, i);
+        MoveRecord record;
+        this->playMove(board, moves[i], record, 0);
+        int score = -this->negamax(board, depth - 1, -INFINITE_SCORE, -alpha, 1);
+        board.unmakeMove(record);
+        if (this->aborted) {
+            break;
+        }
+        if (score > alpha) {
+            alpha = score;
+            bestMove = moves[i];
+        }
+    }
+    if (!this->aborted) {
+        this->tt.store(board.hash, bestMove, true, scoreToTT(alpha, 0), depth, Bound::Exact);
+    }
+    return alpha;
+}
+
+/**
+ * @brief Checks the node budget, and every 1024 nodes the clock and the stop flag.
+ * @return True if the search must stop.
+ */
+bool Search::outOfBudget() {
+    if (this->limits.nodes != 0 && this->nodes >= this->limits.nodes) {
+        return true;
+    }
+    if ((this->nodes & 1023) != 0) {
+        return false;
+    }
+    if (this->limits.stop != nullptr && this->limits.stop->load(std::memory_order_relaxed)) {
+        return true;
+    }
+    return this->limits.timeMs != 0 && this->elapsedMs() >= this->limits.timeMs;
+}
+
+/**
+ * @brief Retrieves the time spent in the current search.
+ * @return Milliseconds since run was called.
+ */
+int Search::elapsedMs() const {
+    auto elapsed = std::chrono::steady_clock::now() - this->startTime;
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+/**
+ * @brief Negamax search with alpha-beta pruning.
+ *
+ * @param board Position to search. Restored before returning.
+ * @param depth Remaining depth.
+ * @param alpha Lower bound of the window.
+ * @param beta Upper bound of the window.
+ * @param ply Distance from the root.
+ * @return Score from the point of view of the side to move.
+ */
+int Search::negamax(Board& board, int depth, int alpha, int beta, int ply) {
+    this->nodes++;
+    if (this->outOfBudget()) {
+        this->aborted = true;
+        return 0;
+    }
+
+    MoveList moves;
+    if (generateMoves(board, moves) == 0) {
+        return terminalScore(board, ply);
+    }
+    if (depth <= 0 || ply >= MAX_PLY) {
+        return this->evaluateLeaf(board, ply);
+    }
+
+    TTEntry entry;
+    const Move* ttMove = nullptr;
+    this->ttProbes++;
+    if (this->tt.probe(board.hash, entry)) {
+        this->ttHits++;
+        if (entry.depth >= depth) {
+            int score = scoreFromTT(entry.score, ply);
+            if (entry.bound == Bound::Exact ||
+                (entry.bound == Bound::Lower && score >= beta) ||
+                (entry.bound == Bound::Upper && score <= alpha)) {
+                return score;
+            }
+        }
+        if (entry.hasMove) {
+            ttMove = &entry.move;
+        }
+    }
+
+    int scores[MAX_MOVES];
+    this->scoreMoves(board, moves, scores, ttMove);
+    this->innerNodes++;
+
+    int alphaOriginal = alpha;
+    int best = -INFINITE_SCORE;
+    Move bestMove = moves[0];
+    for (int i = 0; i < moves.size(); i++) {
+        pickMove(moves, scores, i);
+        MoveRecord record;
+        this->playMove(board, moves[i], record, ply);
+        int score = -this->negamax(board, depth - 1, -beta, -alpha, ply + 1);
+        board.unmakeMove(record);
+        if (this->aborted) {
+            return 0;
+        }
+        if (score > best) {
+            best = score;
+            bestMove = moves[i];
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    this->cutoffs++;
+                    break;
+                }
+            }
+        }
+    }
+
+    Bound bound = best <= alphaOriginal ? Bound::Upper : best >= beta ? Bound::Lower : Bound::Exact;
+    this->tt.store(board.hash, bestMove, true, scoreToTT(best, ply), depth, bound);
+    return best;
+}
+
+/**
+ * @brief Plays a move and, with a network, derives the accumulator of the next ply.
+ * Taking the move back only needs Board::unmakeMove, since the accumulator of this ply is left as it was.
+ *
+ * @param board Position to play the move in.
+ * @param move Move to play.
+ * @param record Filled by makeMove.
+ * @param ply Distance of the position from the root.
+ */
+void Search::playMove(Board& board, const Move& move, MoveRecord& record, int ply) {
+    Side mover = board.sideToMove;
+    board.makeMove(move, record);
+    if (this->network != nullptr) {
+        this->network->update(this->accumulators[ply], this->accumulators[ply + 1], mover, record);
+    }
+}
+
+/**
+ * @brief Scores a leaf with the network if there is one, otherwise with the weights.
+ * Network scores are kept clear of the range that stands for finished games.
+ *
+ * @param board Position to score.
+ * @param ply Distance of the position from the root.
+ * @return Score from the point of view of the side to move.
+ */
+int Search::evaluateLeaf(const Board& board, int ply) const {
+    if (this->network == nullptr) {
+        return evaluate(board, this->weights);
+    }
+    int score = this->network->evaluate(this->accumulators[ply], board.sideToMove);
+    return std::clamp(score, -WIN_SCORE + MAX_PLY + 1, WIN_SCORE - MAX_PLY - 1);
+}
+
+/**
+ * @brief Scores moves for ordering by the material they win straight away.
+ * A clone gains its new pawn plus every flip, a jump only the flips. The transposition table move goes first.
+ *
+ * @param board Position the moves belong to.
+ * @param moves Moves to score.
+ * @param scores Filled with one score per move.
+ * @param ttMove Best move stored for this position, or nullptr.
+ */
+void Search::scoreMoves(const Board& board, const MoveList& moves, int* scores, const Move* ttMove) const {
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    for (int i = 0; i < moves.size(); i++) {
+        int flips = (ADJACENT_CELLS[moves[i].to] & enemy).count();
+        scores[i] = 2 * flips + (moves[i].type == MoveType::Clone ? 1 : 0);
+        if (ttMove != nullptr && moves[i] == *ttMove) {
+            scores[i] = 1000;
+        }
+    }
+}
+
+/**
+ * @brief Moves the best-scored remaining move to the given slot.
+ * Selecting lazily is cheaper than sorting because most nodes cut off after a few moves.
+ *
+ * @param moves Moves being searched.
+ * @param scores Scores matching the moves.
+ * @param from First slot not searched yet.
+ */
+void Search::pickMove(MoveList& moves, int* scores, int from) {
+    int best = from;
+    for (int i = from + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    std::swap(moves[from], moves[best]);
+    std::swap(scores[from], scores[best]);
+}
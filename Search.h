@@ -0,0 +1,101 @@
+#include "Board.h"
+#include "Evaluation.h"
+#include "Move.h"
+#include "Nnue.h"
+#include "TranspositionTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#ifndef HEXXAGON_SEARCH_H
+#define HEXXAGON_SEARCH_H
+
+constexpr int INFINITE_SCORE = 1000000;
+constexpr int WIN_SCORE = 100000;
+constexpr int MAX_PLY = 128;
+
+/**
+ * @brief How far a search may go. A zero node or time budget means no budget.
+ * The search also stops as soon as the optional stop flag is raised.
+ * With fewer than solveEmpty empty cells the endgame solver first looks for a forced win, 0 turns that off.
+ * The default is 8: with 250 ms the solver proved no win in random-game positions with 9 or more empty cells, so a
+ * higher threshold would only spend half of every budget on failed solves.
+ */
+struct SearchLimits {
+    int depth = 4;
+    uint64_t nodes = 0;
+    int timeMs = 0;
+    const std::atomic<bool>* stop = nullptr;
+    int solveEmpty = 8;
+};
+
+/**
+ * @brief Outcome of a search. depthTimesMs holds, per completed depth, the time it was reached.
+ * pv is the expected line starting with bestMove, read back from the transposition table. cutoffs counts the
+ * searched nodes (innerNodes) that stopped early on a beta cutoff.
+ * When the endgame solver found a forced win, solved is set, margin is the final point difference the side to move
+ * wins by at least and depth the number of plies within which the game ends.
+ */
+struct SearchResult {
+    Move bestMove;
+    bool hasMove = false;
+    int score = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    int timeMs = 0;
+    std::vector<int> depthTimesMs;
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;
+    uint64_t innerNodes = 0;
+    uint64_t cutoffs = 0;
+    std::vector<Move> pv;
+    bool solved = false;
+    int margin = 0;
+};
+
+/**
+ * @brief Negamax alpha-beta search, deepened one ply at a time up to the limits.
+ * Searched positions go into a transposition table that may be shared with other searches.
+ * With a network the leaves are scored by it, from accumulators kept per ply along the searched line.
+ */
+class Search {
+public:
+    explicit Search(TranspositionTable& tt, const EvalWeights& weights = EvalWeights(), int threadIndex = 0,
+                    const NnueNetwork* network = nullptr);
+
+    SearchResult run(const Board& board, const SearchLimits& limits);
+    void scoreMoves(const Board& board, const MoveList& moves, int* scores, const Move* ttMove) const;
+    static void pickMove(MoveList& moves, int* scores, int from);
+
+private:
+    TranspositionTable& tt;
+    EvalWeights weights;
+    const NnueNetwork* network = nullptr;
+    std::vector<NnueAccumulator> accumulators;
+    int threadIndex = 0;
+    uint64_t nodes = 0;
+    uint64_t ttProbes = 0;
+    uint64_t ttHits = 0;
+    uint64_t innerNodes = 0;
+    uint64_t cutoffs = 0;
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point startTime;
+    bool aborted = false;
+
+    bool outOfBudget();
+    int elapsedMs() const;
+    int negamax(Board& board, int depth, int alpha, int beta, int ply);
+    void playMove(Board& board, const Move& move, MoveRecord& record, int ply);
+    int evaluateLeaf(const Board& board, int ply) const;
+    int searchRoot(Board& board, int depth, Move& bestMove);
+    std::vector<Move> principalVariation(const Board& board, const Move& bestMove, int length) const;
+};
+
+int terminalScore(const Board& board, int ply);
+int scoreToTT(int score, int ply);
+int scoreFromTT(int score, int ply);
+
+
+#endif //HEXXAGON_SEARCH_H
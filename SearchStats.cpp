@@ -0,0 +1,123 @@
+#include "SearchStats.h"
+#include "Hex.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+//Moves of the principal variation the overlay shows, the log keeps all of them
+constexpr size_t OVERLAY_PV_MOVES = 6;
+
+/**
+ * @brief Collects the statistics of a finished search.
+ *
+ * @param result Result of the search.
+ * @param threads Number of threads it searched with.
+ * @return The statistics. A search without a line of its own, such as Monte Carlo tree search, gets its best move.
+ */
+SearchStats searchStats(const SearchResult& result, int threads) {
+    SearchStats stats;
+    stats.depth = result.depth;
+    stats.nodes = result.nodes;
+    stats.timeMs = result.timeMs;
+    stats.nps = result.timeMs > 0 ? result.nodes * 1000 / result.timeMs : result.nodes;
+    stats.threads = threads;
+    stats.ttHitRate = result.ttProbes > 0 ? static_cast<double>(result.ttHits) / result.ttProbes : 0;
+    stats.cutoffRate = result.innerNodes > 0 ? static_cast<double>(result.cutoffs) / result.innerNodes : 0;
+    stats.score = result.score;
+    stats.pv = result.pv;
+    if (stats.pv.empty() && result.hasMove) {
+        stats.pv.push_back(result.bestMove);
+    }
+    stats.solved = result.solved;
+    stats.margin = result.margin;
+    return stats;
+}
+
+/**
+ * @brief Writes a cell as its column letter and row number, a1 being the top of the left column.
+ */
+static std::string cellText(int cell) {
+    return std::string(1, static_cast<char>('a' + cell / BOARD_SIZE)) + std::to_string(cell % BOARD_SIZE + 1);
+}
+
+/**
+ * @brief Writes a move: a clone as its target cell, a jump as its source followed by its target.
+ *
+ * @param move Move to write.
+ * @return For example "e5" for a clone to e5 and "c4e5" for a jump from c4.
+ */
+std::string moveText(const Move& move) {
+    if (move.type == MoveType::Clone) {
+        return cellText(move.to);
+    }
+    return cellText(move.from) + cellText(move.to);
+}
+
+/**
+ * @brief Writes a count with a k or M suffix once it gets long.
+ */
+static std::string shortCount(uint64_t count) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    if (count >= 1000000) {
+        ss << count / 1e6 << 'M';
+    } else if (count >= 10000) {
+        ss << count / 1e3 << 'k';
+    } else {
+        ss << count;
+    }
+    return ss.str();
+}
+
+/**
+ * @brief Writes the statistics as the few short lines of the analysis overlay.
+ *
+ * @param stats Statistics of a search.
+ * @return Lines separated by newlines.
+ */
+std::string formatSearchStats(const SearchStats& stats) {
+    std::stringstream ss;
+    if (stats.solved) {
+        ss << "forced win by " << stats.margin << "+ in " << stats.depth << " plies\n";
+    } else {
+        ss << "depth " << stats.depth << "  score " << std::showpos << stats.score << std::noshowpos << '\n';
+    }
+    ss << shortCount(stats.nodes) << " nodes  " << shortCount(stats.nps) << " nps\n";
+    ss << stats.timeMs << " ms  " << stats.threads << (stats.threads == 1 ? " thread\n" : " threads\n");
+    ss << "tt hits " << std::lround(100 * stats.ttHitRate) << "%  cutoffs " << std::lround(100 * stats.cutoffRate)
+       << "%\n";
+    ss << "pv";
+    for (size_t i = 0; i < stats.pv.size() && i < OVERLAY_PV_MOVES; i++) {
+        ss << ' ' << moveText(stats.pv[i]);
+    }
+    if (stats.pv.size() > OVERLAY_PV_MOVES) {
+        ss << " ...";
+    }
+    return ss.str();
+}
+
+/**
+ * @brief Writes the statistics as one line of JSON, for a log with one search per line.
+ *
+ * @param stats Statistics of a search.
+ * @param ply Number of moves played before the searched position.
+ * @return A JSON object without a trailing newline.
+ */
+std::string searchStatsJson(const SearchStats& stats, int ply) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "{\"ply\":" << ply << ",\"depth\":" << stats.depth << ",\"score\":" << stats.score
+       << ",\"nodes\":" << stats.nodes << ",\"time_ms\":" << stats.timeMs << ",\"nps\":" << stats.nps
+       << ",\"threads\":" << stats.threads << ",\"tt_hit_rate\":" << stats.ttHitRate
+       << ",\"cutoff_rate\":" << stats.cutoffRate << ",\"solved\":" << (stats.solved ? "true" : "false");
+    if (stats.solved) {
+        ss << ",\"margin\":" << stats.margin;
+    }
+    ss << ",\"pv\":[";
+    for (size_t i = 0; i < stats.pv.size(); i++) {
+        ss << (i > 0 ? "," : "") << '"' << moveText(stats.pv[i]) << '"';
+    }
+    ss << "]}";
+    return ss.str();
+}
@@ -0,0 +1,36 @@
+#include "Move.h"
+#include "Search.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef HEXXAGON_SEARCHSTATS_H
+#define HEXXAGON_SEARCHSTATS_H
+
+/**
+ * @brief What one search of the computer player did, for the analysis overlay and the statistics log.
+ * Rates are fractions between 0 and 1. When the endgame solver found a forced win, solved is set and margin is the
+ * point difference it wins by at least.
+ */
+struct SearchStats {
+    int depth = 0;
+    uint64_t nodes = 0;
+    uint64_t nps = 0;
+    int timeMs = 0;
+    int threads = 1;
+    double ttHitRate = 0;
+    double cutoffRate = 0;
+    int score = 0;
+    std::vector<Move> pv;
+    bool solved = false;
+    int margin = 0;
+};
+
+SearchStats searchStats(const SearchResult& result, int threads);
+std::string moveText(const Move& move);
+std::string formatSearchStats(const SearchStats& stats);
+std::string searchStatsJson(const SearchStats& stats, int ply);
+
+
+#endif //HEXXAGON_SEARCHSTATS_H
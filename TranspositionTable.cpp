@@ -0,0 +1,152 @@
+#include "TranspositionTable.h"
+
+#include <algorithm>
+
+//Bit layout of a packed slot
+constexpr int DEPTH_SHIFT = 32;
+constexpr int BOUND_SHIFT = 40;
+constexpr int FROM_SHIFT = 42;
+constexpr int TO_SHIFT = 49;
+constexpr int TYPE_SHIFT = 56;
+constexpr int HAS_MOVE_SHIFT = 57;
+constexpr int GENERATION_SHIFT = 58;
+constexpr uint8_t GENERATION_MASK = 0x3F;
+
+/**
+ * @brief Constructs a TranspositionTable object.
+ * @param megabytes Memory to use, rounded down to a power-of-two number of slots.
+ */
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    this->resize(megabytes);
+}
+
+/**
+ * @brief Reallocates the table. Must not be called while a search is running.
+ * @param megabytes Memory to use, rounded down to a power-of-two number of slots.
+ */
+void TranspositionTable::resize(size_t megabytes) {
+    size_t wanted = std::max<size_t>(megabytes, 1) * 1024 * 1024 / sizeof(Slot);
+    size_t count = 1;
+    while (count * 2 <= wanted) {
+        count *= 2;
+    }
+    this->slots = std::make_unique<Slot[]>(count);
+    this->slotCount = count;
+    this->clear();
+}
+
+/**
+ * @brief Forgets every stored position.
+ */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < this->slotCount; i++) {
+        this->slots[i].check.store(0, std::memory_order_relaxed);
+        this->slots[i].data.store(0, std::memory_order_relaxed);
+    }
+    this->generation = 0;
+}
+
+/**
+ * @brief Marks the start of a new search so entries of earlier searches become replaceable.
+ */
+void TranspositionTable::newSearch() {
+    this->generation = (this->generation + 1) & GENERATION_MASK;
+}
+
+/**
+ * @brief Looks a position up.
+ *
+ * @param key Zobrist hash of the position.
+ * @param entry Filled with the stored data on a hit.
+ * @return True if the position was found.
+ */
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    const Slot& slot = this->slots[key & (this->slotCount - 1)];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if (data == 0 || (check ^ data) != key) {
+        return false;
+    }
+    unpack(data, entry);
+    return true;
+}
+
+/**
+ * @brief Stores a search result.
+ * An entry of the current search is only replaced by a deeper or equally deep result, or by the same position.
+ *
+ * @param key Zobrist hash of the position.
+ * @param move Best move found.
+ * @param hasMove False if no best move is known.
+ * @param score Score, already adjusted to be independent of the distance from the root.
+ * @param depth Depth the position was searched to.
+ * @param bound Whether the score is exact or a bound.
+ */
+void TranspositionTable::store(uint64_t key, Move move, bool hasMove, int score, int depth, Bound bound) {
+    Slot& slot = this->slots[key & (this->slotCount - 1)];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    uint64_t oldCheck = slot.check.load(std::memory_order_relaxed);
+
+    if (oldData != 0) {
+        TTEntry old;
+        unpack(oldData, old);
+        bool samePosition = (oldCheck ^ oldData) == key;
+        uint8_t oldGeneration = (oldData >> GENERATION_SHIFT) & GENERATION_MASK;
+        if (!samePosition && oldGeneration == this->generation && depth < old.depth) {
+            return;
+        }
+        if (samePosition && !hasMove && old.hasMove) {
+            move = old.move;
+            hasMove = true;
+        }
+    }
+
+    uint64_t data = pack(move, hasMove, score, depth, bound, this->generation);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Estimates how full the table is from a sample of slots.
+ * @return Permille of sampled slots written by the current search.
+ */
+int TranspositionTable::hashfull() const {
+    size_t sample = std::min<size_t>(1000, this->slotCount);
+    int used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        uint64_t data = this->slots[i].data.load(std::memory_order_relaxed);
+        if (data != 0 && ((data >> GENERATION_SHIFT) & GENERATION_MASK) == this->generation) {
+            used++;
+        }
+    }
+    return static_cast<int>(used * 1000 / sample);
+}
+
+/**
+ * @brief Retrieves the memory the table uses.
+ * @return Size in megabytes.
+ */
+size_t TranspositionTable::sizeMegabytes() const {
+    return this->slotCount * sizeof(Slot) / (1024 * 1024);
+}
+
+uint64_t TranspositionTable::pack(const Move& move, bool hasMove, int score, int depth, Bound bound, uint8_t generation) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(score)) |
+           static_cast<uint64_t>(std::clamp(depth, 0, 255)) << DEPTH_SHIFT |
+           static_cast<uint64_t>(bound) << BOUND_SHIFT |
+           static_cast<uint64_t>(move.from) << FROM_SHIFT |
+           static_cast<uint64_t>(move.to) << TO_SHIFT |
+           static_cast<uint64_t>(move.type) << TYPE_SHIFT |
+           static_cast<uint64_t>(hasMove) << HAS_MOVE_SHIFT |
+           static_cast<uint64_t>(generation & GENERATION_MASK) << GENERATION_SHIFT;
+}
+
+void TranspositionTable::unpack(uint64_t data, TTEntry& entry) {
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.depth = static_cast<int>((data >> DEPTH_SHIFT) & 0xFF);
+    entry.bound = static_cast<Bound>((data >> BOUND_SHIFT) & 0x3);
+    entry.move.from = static_cast<uint8_t>((data >> FROM_SHIFT) & 0x7F);
+    entry.move.to = static_cast<uint8_t>((data >> TO_SHIFT) & 0x7F);
+    entry.move.type = static_cast<MoveType>((data >> TYPE_SHIFT) & 0x1);
+    entry.hasMove = ((data >> HAS_MOVE_SHIFT) & 0x1) != 0;
+}
@@ -0,0 +1,65 @@
+#include "Move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#ifndef HEXXAGON_TRANSPOSITIONTABLE_H
+#define HEXXAGON_TRANSPOSITIONTABLE_H
+
+//Range of table sizes the game accepts, in megabytes
+constexpr size_t MIN_HASH_MEGABYTES = 16;
+constexpr size_t MAX_HASH_MEGABYTES = 4096;
+
+enum class Bound : uint8_t {
+    None,
+    Upper,
+    Lower,
+    Exact
+};
+
+/**
+ * @brief Unpacked content of a table slot.
+ */
+struct TTEntry {
+    Move move;
+    bool hasMove = false;
+    int score = 0;
+    int depth = 0;
+    Bound bound = Bound::None;
+};
+
+/**
+ * @brief Fixed-size hash table of searched positions, shared by every search thread without locks.
+ * Each slot holds one packed 64-bit word and a check word (key XOR data). A slot torn by two threads
+ * writing at once fails the check and reads as a miss instead of returning a wrong entry.
+ */
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 64);
+
+    void resize(size_t megabytes);
+    void clear();
+    void newSearch();
+    bool probe(uint64_t key, TTEntry& entry) const;
+    void store(uint64_t key, Move move, bool hasMove, int score, int depth, Bound bound);
+    int hashfull() const;
+    size_t sizeMegabytes() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t slotCount = 0;
+    uint8_t generation = 0;
+
+    static uint64_t pack(const Move& move, bool hasMove, int score, int depth, Bound bound, uint8_t generation);
+    static void unpack(uint64_t data, TTEntry& entry);
+};
+
+
+#endif //HEXXAGON_TRANSPOSITIONTABLE_H
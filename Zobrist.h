@@ -0,0 +1,43 @@
+#include "Board.h"
+
+#include <array>
+#include <cstdint>
+
+#ifndef HEXXAGON_ZOBRIST_H
+#define HEXXAGON_ZOBRIST_H
+
+/**
+ * @brief Random keys for Zobrist hashing, generated at compile time so every build hashes alike.
+ */
+struct ZobristKeys {
+    std::array<uint64_t, CELL_COUNT> white{};
+    std::array<uint64_t, CELL_COUNT> black{};
+    uint64_t blackToMove = 0;
+};
+
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys;
+    uint64_t state = 0x48455858414730ull;
+    for (int i = 0; i < CELL_COUNT; i++) {
+        keys.white[i] = splitMix64(state);
+        keys.black[i] = splitMix64(state);
+    }
+    keys.blackToMove = splitMix64(state);
+    return keys;
+}
+
+constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+constexpr uint64_t zobristKey(Side side, int cell) {
+    return side == Side::White ? ZOBRIST.white[cell] : ZOBRIST.black[cell];
+}
+
+
+#endif //HEXXAGON_ZOBRIST_H
@@ -0,0 +1,358 @@
+#include "BatchEvaluation.h"
+#include "Board.h"
+#include "Evaluation.h"
+#include "Hex.h"
+#include "MoveGen.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+
+#ifdef HEXX_BENCH_RENDER
+#include "Game.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Games played at random to collect the benchmark positions, every POSITION_STRIDE-th position is kept
+constexpr uint64_t CORPUS_SEED = 0x68657878;
+constexpr int POSITION_STRIDE = 3;
+//A timed run repeats the benchmark until it lasts about this long, so short benchmarks are not lost in timer noise
+constexpr double MIN_RUN_NS = 20e6;
+
+/**
+ * @brief A timed operation. run does ops operations once and returns a checksum so nothing is optimised away.
+ */
+struct Benchmark {
+    std::string name;
+    uint64_t ops = 0;
+    std::function<uint64_t()> run;
+};
+
+/**
+ * @brief Timing of one benchmark over every run, in nanoseconds per operation.
+ */
+struct Timing {
+    std::string name;
+    double median = 0;
+    double mean = 0;
+    double stddev = 0;
+    int runs = 0;
+};
+
+/**
+ * @brief Plays random games from the starting position and keeps positions along them.
+ * The seed is fixed, so every run and every build benchmarks the same positions.
+ *
+ * @param count Number of positions to collect.
+ * @return Positions of every stage of the game, none of them finished.
+ */
+std::vector<Board> collectPositions(int count) {
+    std::mt19937_64 random(CORPUS_SEED);
+    std::vector<Board> positions;
+    while (static_cast<int>(positions.size()) < count) {
+        Board board = Board::startingPosition();
+        MoveList moves;
+        for (int ply = 0; generateMoves(board, moves) > 0 && static_cast<int>(positions.size()) < count; ply++) {
+            if (ply % POSITION_STRIDE == 0) {
+                positions.push_back(board);
+            }
+            MoveRecord record;
+            board.makeMove(moves[static_cast<int>(random() % moves.size())], record);
+        }
+    }
+    return positions;
+}
+
+/**
+ * @brief Runs a benchmark repeatedly after one warm-up run.
+ * The warm-up run also sets how often a timed run repeats the benchmark to last at least MIN_RUN_NS.
+ *
+ * @param benchmark Benchmark to time.
+ * @param runs Number of timed runs.
+ * @param sink Receives the checksums.
+ * @return Median, mean and standard deviation of the time per operation.
+ */
+Timing timeBenchmark(const Benchmark& benchmark, int runs, uint64_t& sink) {
+    auto warmUpStart = std::chrono::steady_clock::now();
+    sink += benchmark.run();
+    std::chrono::duration<double, std::nano> warmUp = std::chrono::steady_clock::now() - warmUpStart;
+    int repeats = static_cast<int>(std::clamp(std::ceil(MIN_RUN_NS / std::max(warmUp.count(), 1.0)), 1.0, 1e6));
+
+    std::vector<double> samples;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int repeat = 0; repeat < repeats; repeat++) {
+            sink += benchmark.run();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        samples.push_back(elapsed.count() / (static_cast<double>(benchmark.ops) * repeats));
+    }
+
+    Timing timing;
+    timing.name = benchmark.name;
+    timing.runs = runs;
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    timing.median = runs % 2 == 1 ? sorted[runs / 2] : (sorted[runs / 2 - 1] + sorted[runs / 2]) / 2;
+    for (double sample : samples) {
+        timing.mean += sample / runs;
+    }
+    for (double sample : samples) {
+        timing.stddev += (sample - timing.mean) * (sample - timing.mean) / std::max(1, runs - 1);
+    }
+    timing.stddev = std::sqrt(timing.stddev);
+    return timing;
+}
+
+/**
+ * @brief Writes the timings as JSON, one benchmark per line, for a later --baseline.
+ *
+ * @param path Path of the file.
+ * @param timings Timings to save.
+ * @return False if the file could not be written.
+ */
+bool saveBaseline(const std::string& path, const std::vector<Timing>& timings) {
+    std::ofstream out(path, std::ios::trunc);
+    out << std::fixed << std::setprecision(3);
+    out << "{\"benchmarks\": [" << '\n';
+    for (size_t i = 0; i < timings.size(); i++) {
+        const Timing& t = timings[i];
+        out << "  {\"name\": \"" << t.name << "\", \"ns_per_op\": " << t.median << ", \"mean\": " << t.mean
+            << ", \"stddev\": " << t.stddev << ", \"runs\": " << t.runs << "}" << (i + 1 < timings.size() ? "," : "")
+            << '\n';
+    }
+    out << "]}" << '\n';
+    return out.good();
+}
+
+/**
+ * @brief Reads the median time per operation of every benchmark in a file written by saveBaseline.
+ * Only the "name" and "ns_per_op" fields are read, so the file may be edited by hand as long as each benchmark
+ * stays on a line of its own.
+ *
+ * @param path Path of the file.
+ * @param baseline Filled with the time of every benchmark, by name.
+ * @return False if the file is missing or holds no benchmark.
+ */
+bool loadBaseline(const std::string& path, std::map<std::string, double>& baseline) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t name = line.find("\"name\"");
+        size_t time = line.find("\"ns_per_op\"");
+        if (name == std::string::npos || time == std::string::npos) {
+            continue;
+        }
+        size_t open = line.find('"', line.find(':', name) + 1);
+        size_t close = line.find('"', open + 1);
+        size_t value = line.find(':', time) + 1;
+        if (open == std::string::npos || close == std::string::npos) {
+            continue;
+        }
+        baseline[line.substr(open + 1, close - open - 1)] = std::strtod(line.c_str() + value, nullptr);
+    }
+    return !baseline.empty();
+}
+
+/**
+ * @brief Microbenchmarks of the hot paths of the rules, the evaluation and the search.
+ * Usage: hexx_bench [--runs N] [--positions N] [--filter TEXT] [--save FILE] [--baseline FILE] [--tolerance PCT]
+ *   --runs       timed runs of at least 20 ms per benchmark after a warm-up run (default 15)
+ *   --positions  positions of random games every benchmark works through (default 2000)
+ *   --filter     only run the benchmarks whose name contains TEXT
+ *   --save       write the timings to FILE as a baseline
+ *   --baseline   compare with the timings in FILE and flag every benchmark slower by more than the tolerance
+ *   --tolerance  allowed slowdown in percent before a benchmark counts as a regression (default 10)
+ * Every benchmark reports the median, mean and standard deviation of the nanoseconds per operation over the runs.
+ * Medians are compared, since a single run disturbed by the system moves the mean but not the median.
+ * Built with the GUI, "render" times drawing the board and the pawns into an offscreen texture; it opens a window.
+ *
+ * @return 0 on success, 1 if a file could not be read or written or a benchmark regressed.
+ */
+int main(int argc, char* argv[]) {
+    int runs = 15;
+    int positionCount = 2000;
+    std::string filter;
+    std::string savePath;
+    std::string baselinePath;
+    double tolerance = 10;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--runs") {
+            runs = std::max(1, std::stoi(value));
+        } else if (arg == "--positions") {
+            positionCount = std::max(1, std::stoi(value));
+        } else if (arg == "--filter") {
+            filter = value;
+        } else if (arg == "--save") {
+            savePath = value;
+        } else if (arg == "--baseline") {
+            baselinePath = value;
+        } else if (arg == "--tolerance") {
+            tolerance = std::stod(value);
+        } else {
+            std::cout << "unknown option " << arg << '\n';
+            return 1;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty() && !loadBaseline(baselinePath, baseline)) {
+        std::cout << "couldn't read baseline " << baselinePath << '\n';
+        return 1;
+    }
+
+    std::vector<Board> positions = collectPositions(positionCount);
+    std::vector<MoveList> moveLists(positions.size());
+    std::vector<PackedPosition> packed;
+    uint64_t totalMoves = 0;
+    for (size_t i = 0; i < positions.size(); i++) {
+        totalMoves += generateMoves(positions[i], moveLists[i]);
+        packed.push_back(packPosition(positions[i]));
+    }
+    uint64_t count = positions.size();
+    TranspositionTable tt(1);
+    Search search(tt);
+    EvalWeights weights;
+    std::vector<int> scores(count);
+
+    std::vector<Benchmark> benchmarks;
+    benchmarks.push_back({"movegen", count, [&]() {
+        uint64_t sum = 0;
+        MoveList moves;
+        for (const Board& board : positions) {
+            sum += generateMoves(board, moves);
+        }
+        return sum;
+    }});
+    benchmarks.push_back({"make-unmake", totalMoves, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; i++) {
+            Board& board = positions[i];
+            for (const Move& move : moveLists[i]) {
+                MoveRecord record;
+                sum += board.makeMove(move, record);
+                board.unmakeMove(record);
+            }
+        }
+        return sum;
+    }});
+    //The flips of a move, as makeMove resolves them
+    benchmarks.push_back({"captures", totalMoves, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < count; i++) {
+            Bitboard enemy = positions[i].pieces(opponent(positions[i].sideToMove));
+            for (const Move& move : moveLists[i]) {
+                sum += (ADJACENT_CELLS[move.to] & enemy).count();
+            }
+        }
+        return sum;
+    }});
+    benchmarks.push_back({"eval", count, [&]() {
+        uint64_t sum = 0;
+        for (const Board& board : positions) {
+            sum += evaluate(board, weights);
+        }
+        return sum;
+    }});
+    benchmarks.push_back({"eval-batch", count, [&]() {
+        evaluateBatch(packed.data(), count, weights, scores.data());
+        uint64_t sum = 0;
+        for (int score : scores) {
+            sum += score;
+        }
+        return sum;
+    }});
+    benchmarks.push_back({"hash", count, [&]() {
+        uint64_t sum = 0;
+        for (const Board& board : positions) {
+            sum ^= board.computeHash();
+        }
+        return sum;
+    }});
+    //Ordering as a fully searched node sees it: score every move, then select them best first
+    benchmarks.push_back({"move-sort", totalMoves, [&]() {
+        uint64_t sum = 0;
+        int moveScores[MAX_MOVES];
+        for (size_t i = 0; i < count; i++) {
+            MoveList moves = moveLists[i];
+            search.scoreMoves(positions[i], moves, moveScores, nullptr);
+            for (int m = 0; m < moves.size(); m++) {
+                Search::pickMove(moves, moveScores, m);
+            }
+            sum += moves[0].to;
+        }
+        return sum;
+    }});
+#ifdef HEXX_BENCH_RENDER
+    Game game(1, 0);
+    game.createBoard();
+    game.createPawns();
+    sf::RenderTexture target;
+    if (!target.create({600, 700})) {
+        std::cout << "couldn't create the render texture" << '\n';
+        return 1;
+    }
+    benchmarks.push_back({"render", 100, [&]() {
+        for (int frame = 0; frame < 100; frame++) {
+            target.clear(sf::Color(135, 85, 46));
+            game.renderBoard(target);
+            target.display();
+        }
+        return uint64_t(0);
+    }});
+#endif
+
+    std::vector<Timing> timings;
+    uint64_t sink = 0;
+    int regressions = 0;
+    std::cout << count << " positions, " << totalMoves << " moves, " << runs << " runs" << '\n';
+    std::cout << std::left << std::setw(14) << "benchmark" << std::right << std::setw(12) << "ns/op"
+              << std::setw(12) << "stddev" << std::setw(12) << "baseline" << std::setw(10) << "change" << '\n';
+    std::cout << std::fixed;
+    for (const Benchmark& benchmark : benchmarks) {
+        if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        Timing timing = timeBenchmark(benchmark, runs, sink);
+        timings.push_back(timing);
+        std::cout << std::left << std::setw(14) << timing.name << std::right << std::setprecision(2)
+                  << std::setw(12) << timing.median << std::setw(12) << timing.stddev;
+        auto reference = baseline.find(timing.name);
+        if (reference != baseline.end() && reference->second > 0) {
+            double change = 100 * (timing.median / reference->second - 1);
+            bool regressed = change > tolerance;
+            regressions += regressed ? 1 : 0;
+            std::cout << std::setw(12) << reference->second << std::setprecision(1) << std::setw(9)
+                      << std::showpos << change << std::noshowpos << '%' << (regressed ? "  REGRESSION" : "");
+        }
+        std::cout << '\n';
+    }
+    //Printing the checksum keeps the benchmarked work from being optimised away
+    std::cout << "checksum " << sink << '\n';
+
+    if (!savePath.empty() && !saveBaseline(savePath, timings)) {
+        std::cout << "couldn't write " << savePath << '\n';
+        return 1;
+    }
+    if (regressions > 0) {
+        std::cout << regressions << " benchmark(s) slower than the baseline by more than " << tolerance << "%" << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "Board.h"
+#include "GameRecordReader.h"
+#include "OpeningBook.h"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Builds an opening book from game-record files.
+ * Usage: hexx_book --out FILE [--plies N] [--min-games K] RECORDS...
+ *   --plies      number of opening plies of every game to take into the book (default 12)
+ *   --min-games  leave out moves played in fewer games (default 2)
+ * Every move gets the points its side scored: 2 for a win, 1 for a draw, 0 for a loss.
+ *
+ * @return 0 on success, 1 if a file could not be read or written.
+ */
+int main(int argc, char* argv[]) {
+    std::string outPath;
+    int plies = 12;
+    uint32_t minGames = 2;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--plies" && i + 1 < argc) {
+            plies = std::stoi(argv[++i]);
+        } else if (arg == "--min-games" && i + 1 < argc) {
+            minGames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (outPath.empty() || inputs.empty()) {
+        std::cout << "usage: hexx_book --out FILE [--plies N] [--min-games K] RECORDS..." << '\n';
+        return 1;
+    }
+
+    //Keyed by position hash, then source, target and type of the move
+    std::map<std::pair<uint64_t, uint32_t>, BookEntry> stats;
+    uint64_t games = 0;
+    for (const std::string& input : inputs) {
+        GameRecordReader reader;
+        if (!reader.open(input)) {
+            std::cout << "couldn't read " << input << '\n';
+            return 1;
+        }
+        GameRecord record;
+        while (reader.next(record)) {
+            games++;
+            Board board = Board::startingPosition();
+            for (int ply = 0; ply < plies && ply < static_cast<int>(record.moves.size()); ply++) {
+                const Move& move = record.moves[ply];
+                int own = board.sideToMove == Side::White ? record.whitePoints : record.blackPoints;
+                int other = board.sideToMove == Side::White ? record.blackPoints : record.whitePoints;
+                uint32_t moveKey = move.from << 8 | move.to << 1 | (move.type == MoveType::Jump ? 1 : 0);
+
+                BookEntry& entry = stats[{board.hash, moveKey}];
+                entry.key = board.hash;
+                entry.move = move;
+                entry.games++;
+                entry.points += own > other ? 2 : own == other ? 1 : 0;
+
+                MoveRecord undo;
+                board.makeMove(move, undo);
+            }
+        }
+    }
+
+    std::vector<BookEntry> entries;
+    for (const auto& [key, entry] : stats) {
+        if (entry.games >= minGames) {
+            entries.push_back(entry);
+        }
+    }
+    if (!OpeningBook::write(outPath, entries)) {
+        std::cout << "couldn't write " << outPath << '\n';
+        return 1;
+    }
+    std::cout << games << " games, " << entries.size() << " book moves written to " << outPath << '\n';
+    return 0;
+}
@@ -0,0 +1,22 @@
+# Writes a header holding a file as a constexpr byte array.
+# Usage: cmake -DINPUT=file -DOUTPUT=header -DNAME=IDENTIFIER -P EmbedAsset.cmake
+# The header defines NAME[] and NAME_SIZE.
+
+file(READ "${INPUT}" bytes HEX)
+string(LENGTH "${bytes}" hexLength)
+math(EXPR size "${hexLength} / 2")
+if (size EQUAL 0)
+    message(FATAL_ERROR "Asset ${INPUT} is empty")
+endif ()
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${bytes}")
+string(REPEAT "0x[0-9a-f][0-9a-f]," 24 line)
+string(REGEX REPLACE "(${line})" "\\1\n        " bytes "${bytes}")
+get_filename_component(inputName "${INPUT}" NAME)
+
+file(WRITE "${OUTPUT}.tmp"
+        "//Generated from ${inputName} by EmbedAsset.cmake, do not edit\n"
+        "#include <cstddef>\n\n"
+        "constexpr unsigned char ${NAME}[] = {\n        ${bytes}\n};\n"
+        "constexpr std::size_t ${NAME}_SIZE = ${size};\n")
+file(COPY_FILE "${OUTPUT}.tmp" "${OUTPUT}" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT}.tmp")
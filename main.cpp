@@ -1,25 +1,113 @@
 #include "Game.h"
 
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Reads a whole argument as a positive decimal number.
+ *
+ * @param text Argument to read.
+ * @param value Receives the number.
+ * @return False if the argument holds anything else, does not fit in T or is 0.
+ */
+template <typename T>
+static bool parsePositive(const std::string& text, T& value) {
+    const char* end = text.data() + text.size();
+    auto [last, error] = std::from_chars(text.data(), end, value);
+    return !text.empty() && error == std::errc() && last == end && value > 0;
+}
+
 /**
  * @brief Main function for the game.
+ * Accepts "--threads N" to set how many threads the computer player searches with.
+ * By default every hardware thread is used. "--fps N" caps the frame rate, 60 by default.
+ * "--hash MB" sizes its transposition table, 64 MB by default, kept between 16 MB and 4096 MB.
+ * "--book FILE" sets the opening book of the computer player, Books/opening.hxb by default.
+ * "--weights FILE" sets the evaluation weights of its search, as hexx_tune writes them, Weights/hexx.weights by
+ * default. "--network FILE" sets the network its search evaluates with, Networks/hexx.nnue by default. Without one the
+ * built-in evaluation is used. "--stats FILE" appends the statistics of every computer search to FILE as JSON lines.
+ * Assets missing from the working directory are looked for next to the executable. The music is opened on a worker
+ * thread, so the first frame does not wait for it.
+ *
+ * A missing or invalid number prints the usage.
  *
- * @return 0 upon successful execution.
+ * @return 0 upon successful execution, 1 if an argument is invalid.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    int searchThreads = static_cast<int>(std::thread::hardware_concurrency());
+    unsigned frameRateLimit = 60;
+    size_t hashMegabytes = 64;
+    std::string bookPath = "Books/opening.hxb";
+    bool bookGiven = false;
+    std::string weightsPath = "Weights/hexx.weights";
+    bool weightsGiven = false;
+    std::string networkPath = "Networks/hexx.nnue";
+    bool networkGiven = false;
+    std::string statsPath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        std::string value = i + 1 < argc ? argv[i + 1] : "";
+        bool valid = true;
+        if (arg == "--threads") {
+            valid = parsePositive(value, searchThreads);
+        } else if (arg == "--hash") {
+            valid = parsePositive(value, hashMegabytes);
+            hashMegabytes = std::clamp(hashMegabytes, MIN_HASH_MEGABYTES, MAX_HASH_MEGABYTES);
+        } else if (arg == "--fps") {
+            valid = parsePositive(value, frameRateLimit);
+        } else if (arg == "--book" && i + 1 < argc) {
+            bookPath = value;
+            bookGiven = true;
+        } else if (arg == "--weights" && i + 1 < argc) {
+            weightsPath = value;
+            weightsGiven = true;
+        } else if (arg == "--stats" && i + 1 < argc) {
+            statsPath = value;
+        } else if (arg == "--network" && i + 1 < argc) {
+            networkPath = value;
+            networkGiven = true;
+        }
+        if (!valid) {
+            std::cout << "usage: Hexxagon [--threads N] [--fps N] [--hash MB] [--book FILE] [--weights FILE] "
+                      << "[--network FILE] [--stats FILE]" << '\n';
+            return 1;
+        }
+    }
+
+    setAssetDirectory(std::filesystem::path(argv[0]).parent_path().string());
+
     // Init game
-    Game game;
+    Game game(searchThreads, frameRateLimit, hashMegabytes);
+    if (!game.loadOpeningBook(bookPath) && bookGiven) {
+        std::cout << "Error, opening book couldn't open" << '\n';
+    }
+    if (!game.loadWeights(weightsPath) && weightsGiven) {
+        std::cout << "Error, weights couldn't load" << '\n';
+    }
+    if (!game.loadNetwork(networkPath) && networkGiven) {
+        std::cout << "Error, network couldn't load" << '\n';
+    }
+    if (!statsPath.empty() && !game.openStatsLog(statsPath)) {
+        std::cout << "Error, statistics log couldn't open" << '\n';
+    }
     game.createBoard();
     game.createPawns();
 
     sf::Music music;
-    if (!music.openFromFile("Music\\sans.ogg")) {
-        std::cout << "Error, music file couldn't open" << '\n';
-    }
-
-    music.play();
-    music.setLoop(true);
+    std::future<void> musicStart = std::async(std::launch::async, [&music]() {
+        if (!openMusic(music, Asset::Music)) {
+            std::cout << "Error, music file couldn't open" << '\n';
+            return;
+        }
+        music.play();
+        music.setLoop(true);
+    });
 
-    // Game loop
+    // Game loop, idle until an event or the computer's move changes something
     while (game.running()) {
         // Update
         game.update();
@@ -28,6 +116,7 @@ int main() {
         game.render();
     }
 
+    musicStart.wait();
     music.stop();
 
     return 0;
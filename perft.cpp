@@ -0,0 +1,192 @@
+#include "Board.h"
+#include "MoveGen.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Counts the leaf nodes of the move tree below a position.
+ * Finished games below the given depth are not counted.
+ *
+ * @param board Position to expand. Restored before returning.
+ * @param depth Remaining depth.
+ * @return Number of positions at exactly the given depth.
+ */
+uint64_t perft(Board& board, int depth) {
+    MoveList moves;
+    int count = generateMoves(board, moves);
+    if (depth == 1) {
+        return count;
+    }
+    uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        MoveRecord record;
+        board.makeMove(move, record);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove(record);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Rules computed from the distance between pawn centres as createPawns places them, a second implementation
+ * of hex distance 1 (clone) and 2 (jump). It shares no code with the neighbour tables, so matching counts
+ * cross-check the tables against the geometry of the drawn board. It is not the old GUI rule: that tested
+ * axis-aligned bounding boxes and also allowed some jumps to cells three steps away.
+ */
+class ReferenceRules {
+public:
+    std::array<Piece, CELL_COUNT> cells{};
+    Piece toMove = Piece::White;
+
+    explicit ReferenceRules(const Board& board) {
+        for (int i = 0; i < CELL_COUNT; i++) {
+            this->cells[i] = board.at(i);
+        }
+        this->toMove = board.sideToMove == Side::White ? Piece::White : Piece::Black;
+    }
+
+    //Distance between pawn centres: columns 45 px apart, rows 50 px apart, odd columns 25 px lower.
+    //Neighbours are at most 52 px apart, cells two steps away 87 to 103 px and three steps away over 130 px.
+    static double centreDistance(int a, int b) {
+        double ax = 45.0 * (a / BOARD_SIZE);
+        double ay = 50.0 * (a % BOARD_SIZE) + 25.0 * ((a / BOARD_SIZE) % 2);
+        double bx = 45.0 * (b / BOARD_SIZE);
+        double by = 50.0 * (b % BOARD_SIZE) + 25.0 * ((b / BOARD_SIZE) % 2);
+        return std::hypot(ax - bx, ay - by);
+    }
+
+    static bool adjacent(int a, int b) {
+        return a != b && centreDistance(a, b) <= 52.0;
+    }
+
+    static bool withinJump(int a, int b) {
+        return !adjacent(a, b) && a != b && centreDistance(a, b) <= 105.0;
+    }
+
+    uint64_t perft(int depth) {
+        Piece enemy = this->toMove == Piece::White ? Piece::Black : Piece::White;
+        uint64_t nodes = 0;
+        bool cloneUsed[CELL_COUNT] = {};
+
+        for (int from = 0; from < CELL_COUNT; from++) {
+            if (this->cells[from] != this->toMove) {
+                continue;
+            }
+            for (int to = 0; to < CELL_COUNT; to++) {
+                if (this->cells[to] != Piece::Empty) {
+                    continue;
+                }
+                bool clone = adjacent(from, to);
+                if ((!clone && !withinJump(from, to)) || (clone && cloneUsed[to])) {
+                    continue;
+                }
+                if (clone) {
+                    cloneUsed[to] = true;
+                }
+                if (depth == 1) {
+                    nodes++;
+                    continue;
+                }
+
+                std::array<Piece, CELL_COUNT> saved = this->cells;
+                this->cells[to] = this->toMove;
+                if (!clone) {
+                    this->cells[from] = Piece::Empty;
+                }
+                for (int c = 0; c < CELL_COUNT; c++) {
+                    if (this->cells[c] == enemy && adjacent(to, c)) {
+                        this->cells[c] = this->toMove;
+                    }
+                }
+                Piece mover = this->toMove;
+                this->toMove = enemy;
+                nodes += this->perft(depth - 1);
+                this->toMove = mover;
+                this->cells = saved;
+            }
+        }
+        return nodes;
+    }
+};
+
+/**
+ * @brief Move generation benchmark and correctness check.
+ * Usage: hexx_perft [depth] [--divide] [--verify] [--position TEXT]
+ *   --divide    print the leaf count below every root move
+ *   --verify    also count with reference rules that measure hex distance from pawn centres, and compare
+ *   --position  start from a position written by Board::toString instead of the starting position
+ *
+ * @return 0 on success, 1 if an argument is invalid or verification found a mismatch.
+ */
+int main(int argc, char* argv[]) {
+    int depth = 5;
+    bool divide = false;
+    bool verify = false;
+    Board board = Board::startingPosition();
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--divide") {
+            divide = true;
+        } else if (arg == "--verify") {
+            verify = true;
+        } else if (arg == "--position" && i + 1 < argc) {
+            if (!Board::fromString(argv[++i], board)) {
+                std::cout << "invalid position" << '\n';
+                return 1;
+            }
+        } else if (!arg.empty() && arg.size() < 4 &&
+                   std::all_of(arg.begin(), arg.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            depth = std::stoi(arg);
+        } else {
+            std::cout << "usage: hexx_perft [depth] [--divide] [--verify] [--position TEXT]" << '\n';
+            return 1;
+        }
+    }
+    if (depth < 1) {
+        std::cout << "depth must be at least 1" << '\n';
+        return 1;
+    }
+
+    bool mismatch = false;
+
+    for (int d = 1; d <= depth; d++) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = perft(board, d);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double nps = seconds > 0 ? nodes / seconds : 0;
+        std::cout << "perft " << d << ": " << nodes << " nodes in " << seconds * 1000 << " ms, "
+                  << static_cast<uint64_t>(nps) << " nps";
+
+        if (verify) {
+            uint64_t reference = ReferenceRules(board).perft(d);
+            std::cout << (reference == nodes ? ", hex-distance reference ok" : ", HEX-DISTANCE REFERENCE MISMATCH: ");
+            if (reference != nodes) {
+                std::cout << reference;
+                mismatch = true;
+            }
+        }
+        std::cout << '\n';
+    }
+
+    if (divide) {
+        MoveList moves;
+        generateMoves(board, moves);
+        for (const Move& move : moves) {
+            MoveRecord record;
+            board.makeMove(move, record);
+            uint64_t nodes = depth > 1 ? perft(board, depth - 1) : 1;
+            board.unmakeMove(record);
+            std::cout << static_cast<int>(move.from) << (move.type == MoveType::Clone ? "+" : "-")
+                      << static_cast<int>(move.to) << ": " << nodes << '\n';
+        }
+    }
+
+    return mismatch ? 1 : 0;
+}
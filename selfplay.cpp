@@ -0,0 +1,382 @@
+#include "Board.h"
+#include "Engine.h"
+#include "GameRecordWriter.h"
+#include "Mcts.h"
+#include "OpeningBook.h"
+#include "MoveGen.h"
+#include "Nnue.h"
+#include "ParallelSearch.h"
+#include "TranspositionTable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Games still running after this many plies are decided on material
+constexpr int MAX_GAME_PLIES = 500;
+//Time per move of a spec that sets no depth, time or node limit, the same as the game's computer player
+constexpr int DEFAULT_TIME_MS = 500;
+
+/**
+ * @brief Reads a whole string as a decimal number, an optional minus sign first.
+ *
+ * @param text Text to read.
+ * @param value Receives the number.
+ * @return False if the text is empty, holds anything else or does not fit.
+ */
+bool parseNumber(const std::string& text, long long& value) {
+    const char* end = text.data() + text.size();
+    auto [last, error] = std::from_chars(text.data(), end, value);
+    return !text.empty() && error == std::errc() && last == end;
+}
+
+/**
+ * @brief Engine configuration of one side, parsed from "ab:depth=6,time=100" or "mcts:time=200,nodes=50000".
+ */
+struct EngineSpec {
+    std::string text;
+    std::string type = "ab";
+    SearchLimits limits;
+    EvalWeights weights;
+    bool useTuned = false;
+    bool useNetwork = false;
+    size_t hashMegabytes = 16;
+
+    /**
+     * @brief Parses a spec. One that sets no depth, time or node limit searches DEFAULT_TIME_MS per move.
+     *
+     * @param text Spec to parse.
+     * @param spec Receives the parsed spec.
+     * @return False on an unknown engine type or key, an option without a value or a value that is not a number.
+     */
+    static bool parse(const std::string& text, EngineSpec& spec) {
+        spec = EngineSpec();
+        spec.text = text;
+        spec.limits.depth = MAX_PLY;
+        size_t colon = text.find(':');
+        spec.type = text.substr(0, colon);
+        if (spec.type != "ab" && spec.type != "mcts") {
+            return false;
+        }
+        bool limited = false;
+        std::stringstream options(colon == std::string::npos ? "" : text.substr(colon + 1));
+        std::string option;
+        while (std::getline(options, option, ',')) {
+            size_t equals = option.find('=');
+            long long value = 0;
+            if (equals == std::string::npos || !parseNumber(option.substr(equals + 1), value)) {
+                return false;
+            }
+            std::string key = option.substr(0, equals);
+            if (key == "depth") {
+                spec.limits.depth = static_cast<int>(value);
+                limited = true;
+            } else if (key == "time") {
+                spec.limits.timeMs = static_cast<int>(value);
+                limited = true;
+            } else if (key == "nodes") {
+                spec.limits.nodes = static_cast<uint64_t>(value);
+                limited = true;
+            } else if (key == "solve") {
+                spec.limits.solveEmpty = static_cast<int>(value);
+            } else if (key == "material") {
+                spec.weights.material = static_cast<int>(value);
+            } else if (key == "mobility") {
+                spec.weights.mobility = static_cast<int>(value);
+            } else if (key == "safety") {
+                spec.weights.safety = static_cast<int>(value);
+            } else if (key == "tuned") {
+                spec.useTuned = value != 0;
+            } else if (key == "nnue") {
+                spec.useNetwork = value != 0;
+            } else if (key == "hash") {
+                spec.hashMegabytes = static_cast<size_t>(value);
+            } else {
+                return false;
+            }
+        }
+        if (!limited) {
+            spec.limits.timeMs = DEFAULT_TIME_MS;
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief An engine built from a spec, with the table "ab" searches with. One per side per worker thread.
+ * hash=MB sizes the table of "ab" and the node pool of "mcts", so a player never holds more than that.
+ */
+struct EnginePlayer {
+    EngineSpec spec;
+    std::unique_ptr<TranspositionTable> tt;
+    std::unique_ptr<Engine> engine;
+
+    EnginePlayer(const EngineSpec& spec, const NnueNetwork* network) : spec(spec) {
+        if (spec.type == "mcts") {
+            size_t poolNodes = std::max<size_t>(1, spec.hashMegabytes * 1024 * 1024 / sizeof(MctsNode));
+            this->engine = std::make_unique<Mcts>(1, spec.weights, poolNodes);
+        } else {
+            this->tt = std::make_unique<TranspositionTable>(spec.hashMegabytes);
+            this->engine = std::make_unique<ParallelSearch>(*this->tt, 1, spec.weights, spec.useNetwork ? network : nullptr);
+        }
+    }
+};
+
+struct GameOutcome {
+    int whiteScore = 0;
+    int blackScore = 0;
+    int plies = 0;
+    std::vector<Move> moves;
+};
+
+/**
+ * @brief Plays one game between two engines.
+ * A few random plies at the start keep deterministic engines from repeating the same game.
+ *
+ * @param white Engine playing white.
+ * @param black Engine playing black.
+ * @param randomPlies Number of random opening plies.
+ * @param seed Seed of the random opening.
+ * @param book Opening book consulted before searching, or nullptr.
+ * @param bookPlies Number of plies from the start in which the book is consulted.
+ * @return Final pawn counts, the remaining empty cells going to the side that still could move, and the moves.
+ */
+GameOutcome playGame(EnginePlayer& white, EnginePlayer& black, int randomPlies, uint64_t seed,
+                     const OpeningBook* book, int bookPlies) {
+    Board board = Board::startingPosition();
+    GameOutcome outcome;
+    uint64_t rng = seed | 1;
+    auto nextRandom = [&rng]() {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        return rng;
+    };
+
+    while (outcome.plies < MAX_GAME_PLIES) {
+        if (board.isGameOver()) {
+            break;
+        }
+        MoveList moves;
+        generateMoves(board, moves);
+        Move move;
+        if (outcome.plies < randomPlies) {
+            move = moves[static_cast<int>(nextRandom() % moves.size())];
+        } else if (book == nullptr || outcome.plies >= bookPlies || !book->probe(board, nextRandom(), move)) {
+            EnginePlayer& player = board.sideToMove == Side::White ? white : black;
+            SearchResult result = player.engine->run(board, player.spec.limits);
+            move = result.bestMove;
+        }
+        MoveRecord record;
+        board.makeMove(move, record);
+        outcome.moves.push_back(move);
+        outcome.plies++;
+    }
+
+    outcome.whiteScore = board.finalCount(Side::White);
+    outcome.blackScore = board.finalCount(Side::Black);
+    return outcome;
+}
+
+/**
+ * @brief Elo difference for an expected score.
+ * @param score Expected score in (0, 1).
+ */
+double eloFromScore(double score) {
+    score = std::clamp(score, 1e-6, 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+/**
+ * @brief Plays many engine-vs-engine games without a window and reports the match statistics.
+ * Usage: hexx_selfplay [--games N] [--threads T] [--a SPEC] [--b SPEC] [--random-plies K] [--seed S] [--record FILE]
+ *                      [--book FILE] [--book-plies N] [--weights FILE] [--network FILE]
+ * SPEC is "ab" or "mcts" followed by optional ":depth=D,time=MS,nodes=N,hash=MB,solve=E".
+ * hash is the memory of each player in MB (default 16): the transposition table of "ab", the tree of "mcts".
+ * A SPEC without depth, time or nodes searches 500 ms per move.
+ * material, mobility and safety set the evaluation weights of "ab", tuned=1 takes them from the --weights file instead,
+ * as hexx_tune writes it, and nnue=1 makes it evaluate with the --network file.
+ * solve=E lets "ab" look for forced wins with the endgame solver below E empty cells (default 8, 0 turns it off).
+ * With --record every game is appended to FILE in the binary game-record format, with an index in FILE.idx.
+ * With --book both engines play from the opening book FILE in the first --book-plies plies (default 12).
+ * Engines alternate colours every game. Results are from engine A's point of view.
+ *
+ * @return 0 upon successful execution, 1 if an argument is invalid or a file could not be opened.
+ */
+int main(int argc, char* argv[]) {
+    int games = 100;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int randomPlies = 2;
+    uint64_t seed = 1;
+    EngineSpec specA;
+    EngineSpec specB;
+    EngineSpec::parse("ab:depth=3", specA);
+    EngineSpec::parse("ab:depth=2", specB);
+    std::string recordPath;
+    std::string bookPath;
+    int bookPlies = 12;
+    std::string weightsPath;
+    std::string networkPath;
+
+    for (int i = 1; i < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = i + 1 < argc ? argv[i + 1] : "";
+        long long number = 0;
+        bool valid = i + 1 < argc;
+        if (arg == "--games") {
+            valid = valid && parseNumber(value, number);
+            games = static_cast<int>(number);
+        } else if (arg == "--threads") {
+            valid = valid && parseNumber(value, number);
+            threads = static_cast<int>(std::max(1ll, number));
+        } else if (arg == "--a") {
+            valid = valid && EngineSpec::parse(value, specA);
+        } else if (arg == "--b") {
+            valid = valid && EngineSpec::parse(value, specB);
+        } else if (arg == "--random-plies") {
+            valid = valid && parseNumber(value, number);
+            randomPlies = static_cast<int>(number);
+        } else if (arg == "--seed") {
+            valid = valid && parseNumber(value, number);
+            seed = static_cast<uint64_t>(number);
+        } else if (arg == "--record") {
+            recordPath = value;
+        } else if (arg == "--book") {
+            bookPath = value;
+        } else if (arg == "--book-plies") {
+            valid = valid && parseNumber(value, number);
+            bookPlies = static_cast<int>(number);
+        } else if (arg == "--weights") {
+            weightsPath = value;
+        } else if (arg == "--network") {
+            networkPath = value;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cout << "usage: hexx_selfplay [--games N] [--threads T] [--a SPEC] [--b SPEC] [--random-plies K] "
+                      << "[--seed S] [--record FILE] [--book FILE] [--book-plies N] [--weights FILE] [--network FILE]"
+                      << '\n' << "SPEC: ab|mcts[:depth=D,time=MS,nodes=N,hash=MB,solve=E,material=M,mobility=M,"
+                      << "safety=S,tuned=0|1,nnue=0|1]" << '\n';
+            return 1;
+        }
+    }
+
+    std::unique_ptr<GameRecordWriter> writer;
+    if (!recordPath.empty()) {
+        writer = std::make_unique<GameRecordWriter>(recordPath);
+        if (!writer->isOpen()) {
+            std::cout << "couldn't open " << recordPath << '\n';
+            return 1;
+        }
+    }
+
+    OpeningBook book;
+    if (!bookPath.empty() && !book.open(bookPath)) {
+        std::cout << "couldn't open " << bookPath << '\n';
+        return 1;
+    }
+    const OpeningBook* bookUsed = book.isOpen() ? &book : nullptr;
+
+    for (EngineSpec* spec : {&specA, &specB}) {
+        if (spec->useTuned && !loadEvalWeights(weightsPath, spec->weights)) {
+            std::cout << "couldn't load weights " << weightsPath << '\n';
+            return 1;
+        }
+    }
+
+    NnueNetwork network;
+    if ((specA.useNetwork || specB.useNetwork) && !network.load(networkPath)) {
+        std::cout << "couldn't load network " << networkPath << '\n';
+        return 1;
+    }
+
+    std::atomic<int> nextGame{0};
+    std::mutex resultMutex;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    uint64_t totalPlies = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            EnginePlayer a(specA, &network);
+            EnginePlayer b(specB, &network);
+            for (int game = nextGame++; game < games; game = nextGame++) {
+                //Pairs of games share an opening with colours swapped
+                bool aIsWhite = game % 2 == 0;
+                uint64_t gameSeed = seed * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(game / 2);
+                GameOutcome outcome = aIsWhite ? playGame(a, b, randomPlies, gameSeed, bookUsed, bookPlies)
+                                                : playGame(b, a, randomPlies, gameSeed, bookUsed, bookPlies);
+                int aScore = aIsWhite ? outcome.whiteScore : outcome.blackScore;
+                int bScore = aIsWhite ? outcome.blackScore : outcome.whiteScore;
+
+                if (writer) {
+                    GameRecord record;
+                    record.moves = std::move(outcome.moves);
+                    record.whitePoints = outcome.whiteScore;
+                    record.blackPoints = outcome.blackScore;
+                    record.timestamp = static_cast<int64_t>(std::time(nullptr));
+                    record.whiteEngine = aIsWhite ? specA.text : specB.text;
+                    record.blackEngine = aIsWhite ? specB.text : specA.text;
+                    writer->append(record);
+                }
+
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (aScore > bScore) {
+                    wins++;
+                } else if (aScore < bScore) {
+                    losses++;
+                } else {
+                    draws++;
+                }
+                totalPlies += outcome.plies;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int played = wins + draws + losses;
+    if (played == 0) {
+        std::cout << "no games played" << '\n';
+        return 0;
+    }
+    double score = (wins + 0.5 * draws) / played;
+    //Wilson score interval: unlike score +- 1.96 standard errors it stays inside (0, 1) and stays wide after a sweep
+    double z2 = 1.96 * 1.96;
+    double centre = (score + z2 / (2.0 * played)) / (1.0 + z2 / played);
+    double margin = 1.96 * std::sqrt(score * (1.0 - score) / played + z2 / (4.0 * played * played)) /
+                    (1.0 + z2 / played);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "games: " << played << "  A wins: " << wins << "  draws: " << draws << "  A losses: " << losses << '\n';
+    std::cout << "score: " << score * 100 << "%  Elo A-B: ";
+    if (wins == played) {
+        std::cout << "> " << eloFromScore(centre - margin) << " (95%, a sweep has no finite estimate)" << '\n';
+    } else if (losses == played) {
+        std::cout << "< " << eloFromScore(centre + margin) << " (95%, a sweep has no finite estimate)" << '\n';
+    } else {
+        std::cout << eloFromScore(score) << " (95% " << eloFromScore(centre - margin) << " .. "
+                  << eloFromScore(centre + margin) << ")" << '\n';
+    }
+    std::cout << "average length: " << static_cast<double>(totalPlies) / played << " plies" << '\n';
+    std::cout << std::setprecision(2) << "throughput: " << played / seconds << " games/s on " << threads << " threads" << '\n';
+    return 0;
+}
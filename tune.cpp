@@ -0,0 +1,268 @@
+#include "BatchEvaluation.h"
+#include "Board.h"
+#include "Evaluation.h"
+#include "GameRecordReader.h"
+#include "Hex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Number of weights the tuner fits: mobility and safety. Material stays at 100 so scores keep their unit.
+constexpr int TUNED_TERMS = 2;
+
+/**
+ * @brief Positions taken from the games, with the result the side to move went on to score (1, 0.5 or 0).
+ */
+struct Dataset {
+    std::vector<PackedPosition> positions;
+    std::vector<float> results;
+    std::vector<EvalFeatures> features;
+};
+
+/**
+ * @brief Tells whether the side to move has no move that flips a pawn.
+ * Scores of such positions do not swing on the next capture, so they fit the final result better.
+ */
+bool isQuiet(const Board& board) {
+    Bitboard own = board.pieces(board.sideToMove);
+    Bitboard enemy = board.pieces(opponent(board.sideToMove));
+    return (cellsWithinTwo(own) & board.empty() & adjacentCells(enemy)).none();
+}
+
+/**
+ * @brief Replays every game of a record file and keeps its positions after the opening.
+ *
+ * @param path Path of the record file.
+ * @param skipPlies Opening plies left out of every game.
+ * @param quietOnly Whether positions with a capture for the side to move are left out.
+ * @param dataset Positions and results are appended to it.
+ * @param games Incremented per game read.
+ * @return False if the file could not be read.
+ */
+bool readGames(const std::string& path, int skipPlies, bool quietOnly, Dataset& dataset, uint64_t& games) {
+    GameRecordReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    GameRecord record;
+    while (reader.next(record)) {
+        games++;
+        float whiteResult = record.whitePoints > record.blackPoints ? 1.0f
+                          : record.whitePoints == record.blackPoints ? 0.5f : 0.0f;
+        Board board = Board::startingPosition();
+        for (size_t ply = 0; ply < record.moves.size(); ply++) {
+            if (static_cast<int>(ply) >= skipPlies && (!quietOnly || isQuiet(board))) {
+                dataset.positions.push_back(packPosition(board));
+                dataset.results.push_back(board.sideToMove == Side::White ? whiteResult : 1.0f - whiteResult);
+            }
+            MoveRecord undo;
+            board.makeMove(record.moves[ply], undo);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Tuned weights as real numbers, so steps smaller than one still move them.
+ */
+struct TunedWeights {
+    double material = 0;
+    double values[TUNED_TERMS] = {};
+
+    double score(const EvalFeatures& features) const {
+        return this->material * features.material + this->values[0] * features.mobility +
+               this->values[1] * features.safety;
+    }
+};
+
+/**
+ * @brief Loss over the dataset and its gradient with respect to the tuned weights.
+ */
+struct Pass {
+    double loss = 0;
+    double gradient[TUNED_TERMS] = {};
+};
+
+/**
+ * @brief Computes the mean logistic loss of the dataset and its gradient, split over threads.
+ * A score s predicts the result 1 / (1 + 10^(-k * s / 400)).
+ *
+ * @param dataset Positions with their features and results.
+ * @param weights Weights to score with.
+ * @param k Scale of the scores.
+ * @param threads Number of threads.
+ * @return Mean loss and gradient.
+ */
+Pass computePass(const Dataset& dataset, const TunedWeights& weights, double k, int threads) {
+    size_t count = dataset.features.size();
+    double scale = k * std::log(10.0) / 400.0;
+    std::vector<Pass> partial(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            Pass& pass = partial[t];
+            for (size_t i = count * t / threads; i < count * (t + 1) / threads; i++) {
+                const EvalFeatures& f = dataset.features[i];
+                double result = dataset.results[i];
+                double predicted = 1.0 / (1.0 + std::exp(-scale * weights.score(f)));
+                predicted = std::clamp(predicted, 1e-12, 1.0 - 1e-12);
+                pass.loss -= result * std::log(predicted) + (1.0 - result) * std::log(1.0 - predicted);
+                double error = (predicted - result) * scale;
+                pass.gradient[0] += error * f.mobility;
+                pass.gradient[1] += error * f.safety;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    Pass total;
+    for (const Pass& pass : partial) {
+        total.loss += pass.loss / static_cast<double>(count);
+        for (int j = 0; j < TUNED_TERMS; j++) {
+            total.gradient[j] += pass.gradient[j] / static_cast<double>(count);
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Finds the score scale that fits the current weights best, by golden-section search on its logarithm.
+ */
+double fitScale(const Dataset& dataset, const TunedWeights& weights, int threads) {
+    const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+    double low = std::log(0.01);
+    double high = std::log(10.0);
+    for (int step = 0; step < 40; step++) {
+        double a = high - ratio * (high - low);
+        double b = low + ratio * (high - low);
+        if (computePass(dataset, weights, std::exp(a), threads).loss <
+            computePass(dataset, weights, std::exp(b), threads).loss) {
+            high = b;
+        } else {
+            low = a;
+        }
+    }
+    return std::exp((low + high) / 2.0);
+}
+
+/**
+ * @brief Fits the evaluation weights to the results of recorded games (Texel tuning).
+ * Usage: hexx_tune --out FILE [--threads T] [--skip-plies N] [--iterations N] [--quiet] [--start FILE] RECORDS...
+ *   --threads     threads of the gradient passes (default: every hardware thread)
+ *   --skip-plies  opening plies of every game left out (default 8)
+ *   --iterations  gradient steps (default 2000)
+ *   --quiet       only positions where the side to move has no capture; in Hexxagon these are rare (about one in ten)
+ *   --start       weights file to start from instead of the built-in weights
+ * Positions of every game are scored with the evaluation terms, computed in batches, and the weights are
+ * fitted by Adam steps on the logistic loss against the final results. The score scale is fitted once first.
+ * The output is a weights file the game, selfplay and loadEvalWeights read.
+ *
+ * @return 0 on success, 1 if a file could not be read or written.
+ */
+int main(int argc, char* argv[]) {
+    std::string outPath;
+    std::string startPath;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int skipPlies = 8;
+    int iterations = 2000;
+    bool quietOnly = false;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--skip-plies" && i + 1 < argc) {
+            skipPlies = std::stoi(argv[++i]);
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::stoi(argv[++i]);
+        } else if (arg == "--quiet") {
+            quietOnly = true;
+        } else if (arg == "--start" && i + 1 < argc) {
+            startPath = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (outPath.empty() || inputs.empty()) {
+        std::cout << "usage: hexx_tune --out FILE [--threads T] [--skip-plies N] [--iterations N] [--quiet] "
+                  << "[--start FILE] RECORDS..." << '\n';
+        return 1;
+    }
+
+    EvalWeights weights;
+    if (!startPath.empty() && !loadEvalWeights(startPath, weights)) {
+        std::cout << "couldn't read weights " << startPath << '\n';
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Dataset dataset;
+    uint64_t games = 0;
+    for (const std::string& input : inputs) {
+        if (!readGames(input, skipPlies, quietOnly, dataset, games)) {
+            std::cout << "couldn't read " << input << '\n';
+            return 1;
+        }
+    }
+    if (dataset.positions.empty()) {
+        std::cout << "no positions found" << '\n';
+        return 1;
+    }
+    dataset.features.resize(dataset.positions.size());
+    evaluationFeaturesBatch(dataset.positions.data(), dataset.positions.size(), dataset.features.data());
+    double readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << games << " games, " << dataset.positions.size() << " positions read in " << readSeconds
+              << " s" << '\n';
+
+    TunedWeights tuned;
+    tuned.material = weights.material;
+    tuned.values[0] = weights.mobility;
+    tuned.values[1] = weights.safety;
+    double k = fitScale(dataset, tuned, threads);
+    std::cout << std::setprecision(4) << "scale k = " << k << ", loss " << computePass(dataset, tuned, k, threads).loss
+              << '\n';
+
+    //Adam steps, with the step size in weight units
+    const double learningRate = 0.5;
+    const double beta1 = 0.9;
+    const double beta2 = 0.999;
+    double* values = tuned.values;
+    double moment[TUNED_TERMS] = {};
+    double velocity[TUNED_TERMS] = {};
+    for (int step = 1; step <= iterations; step++) {
+        Pass pass = computePass(dataset, tuned, k, threads);
+        for (int j = 0; j < TUNED_TERMS; j++) {
+            moment[j] = beta1 * moment[j] + (1 - beta1) * pass.gradient[j];
+            velocity[j] = beta2 * velocity[j] + (1 - beta2) * pass.gradient[j] * pass.gradient[j];
+            double correctedMoment = moment[j] / (1 - std::pow(beta1, step));
+            double correctedVelocity = velocity[j] / (1 - std::pow(beta2, step));
+            values[j] -= learningRate * correctedMoment / (std::sqrt(correctedVelocity) + 1e-12);
+        }
+        if (step % 200 == 0 || step == iterations) {
+            std::cout << "step " << step << ": loss " << pass.loss << ", mobility " << values[0] << ", safety "
+                      << values[1] << '\n';
+        }
+    }
+    weights.mobility = static_cast<int>(std::lround(values[0]));
+    weights.safety = static_cast<int>(std::lround(values[1]));
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::setprecision(2) << "material " << weights.material << ", mobility " << weights.mobility
+              << ", safety " << weights.safety << " in " << seconds << " s on " << threads << " threads" << '\n';
+    if (!saveEvalWeights(outPath, weights)) {
+        std::cout << "couldn't write " << outPath << '\n';
+        return 1;
+    }
+    return 0;
+}